@@ -33,9 +33,8 @@ public:
         }
     }
 
-    auto execute_example_control(ExampleControl& packet) -> ExampleControlAckVX override
+    auto execute_example_control(ExampleControl& packet, ExampleControlAckVX& ack) -> void override
     {
-        auto ack = ExampleControlAckVX{};
         std::cout << "Received example control packet" << std::endl;
         if (packet.bandwidth().has_value()) {
             std::cout << "  - Bandwidth       : " << packet.bandwidth().value() << std::endl;
@@ -70,7 +69,6 @@ public:
                 }
             }
         }
-        return ack;
     }
 
 private:
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026 Geon Technologies, LLC
+ *
+ * This file is part of vrtgen.
+ *
+ * vrtgen is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * vrtgen is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace vrtgen::io {
+
+/**
+ * @brief Pin the calling thread to a single CPU
+ * @param cpu Index of the CPU to run on
+ * @return true on success, otherwise false
+ */
+inline bool pin_current_thread(const int cpu)
+{
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+}
+
+} // end namespace vrtgen::io
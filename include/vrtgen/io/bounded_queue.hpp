@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2026 Geon Technologies, LLC
+ *
+ * This file is part of vrtgen.
+ *
+ * vrtgen is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * vrtgen is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+
+namespace vrtgen::io {
+
+/**
+ * @enum overflow_policy
+ * @brief Action taken when pushing to a full bounded_queue
+ */
+enum class overflow_policy
+{
+    drop_newest, //!< Discard the element being pushed
+    drop_oldest, //!< Discard the oldest queued element to make room
+    block //!< Wait until a consumer makes room
+};
+
+/**
+ * @struct queue_stats
+ * @brief Cumulative bounded_queue counters
+ */
+struct queue_stats
+{
+    uint64_t pushed{}; //!< Elements successfully queued
+    uint64_t popped{}; //!< Elements handed to a consumer
+    uint64_t dropped{}; //!< Elements discarded by the overflow policy
+
+    queue_stats& operator+=(const queue_stats& other) noexcept
+    {
+        pushed += other.pushed;
+        popped += other.popped;
+        dropped += other.dropped;
+        return *this;
+    }
+};
+
+/**
+ * @class bounded_queue
+ * @brief Lock-free bounded multi-producer/multi-consumer queue
+ *
+ * Fixed ring of preallocated slots using per-slot sequence numbers (Vyukov's
+ * bounded MPMC algorithm). Elements are filled and consumed in place through
+ * callbacks, so slot storage such as vector capacity is reused rather than
+ * reallocated for every element.
+ *
+ * The try_ functions never block. push() applies an overflow_policy when the
+ * queue is full and pop() waits for an element until the queue is closed.
+ */
+template <class T>
+class bounded_queue
+{
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Number of slots, rounded up to a power of 2
+     */
+    explicit bounded_queue(const std::size_t capacity) :
+        m_mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+        m_cells(std::make_unique<cell[]>(m_mask + 1))
+    {
+        for (auto i = std::size_t{}; i <= m_mask; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bounded_queue(const bounded_queue&) = delete;
+    bounded_queue& operator=(const bounded_queue&) = delete;
+
+    /**
+     * @brief Push an element if there is room
+     * @param fill Function called as fill(T&) to populate the slot in place
+     * @return true if the element was queued, false if the queue is full
+     */
+    template <class F>
+    bool try_push(F&& fill)
+    {
+        auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        cell* target;
+        while (true) {
+            target = &m_cells[pos & m_mask];
+            const auto seq = target->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        fill(target->value);
+        target->sequence.store(pos + 1, std::memory_order_release);
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        m_push_events.fetch_add(1, std::memory_order_release);
+        m_push_events.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Pop an element if one is available
+     * @param consume Function called as consume(T&) with the oldest element
+     * @return true if an element was consumed, false if the queue is empty
+     */
+    template <class F>
+    bool try_pop(F&& consume)
+    {
+        auto pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        cell* target;
+        while (true) {
+            target = &m_cells[pos & m_mask];
+            const auto seq = target->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        consume(target->value);
+        target->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        m_popped.fetch_add(1, std::memory_order_relaxed);
+        m_pop_events.fetch_add(1, std::memory_order_release);
+        m_pop_events.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Push an element, applying an overflow policy if the queue is full
+     * @param fill Function called as fill(T&) to populate the slot in place
+     * @param policy Action to take when the queue is full
+     * @return true if the element was queued, false if it was dropped or the queue was closed
+     */
+    template <class F>
+    bool push(F&& fill, const overflow_policy policy)
+    {
+        while (!try_push(fill)) {
+            switch (policy) {
+            case overflow_policy::drop_newest:
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            case overflow_policy::drop_oldest:
+                if (try_pop([](T&) {})) {
+                    // Undo the pop count, this element was discarded not consumed
+                    m_popped.fetch_sub(1, std::memory_order_relaxed);
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            case overflow_policy::block:
+                {
+                    const auto events = m_pop_events.load(std::memory_order_acquire);
+                    if (try_push(fill)) {
+                        return true;
+                    }
+                    if (m_closed.load(std::memory_order_acquire)) {
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    m_pop_events.wait(events, std::memory_order_acquire);
+                }
+                break;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Pop an element, waiting until one is available or the queue is closed
+     * @param consume Function called as consume(T&) with the oldest element
+     * @return true if an element was consumed, false if the queue is closed and empty
+     */
+    template <class F>
+    bool pop(F&& consume)
+    {
+        while (true) {
+            const auto events = m_push_events.load(std::memory_order_acquire);
+            if (try_pop(consume)) {
+                return true;
+            }
+            if (m_closed.load(std::memory_order_acquire)) {
+                return try_pop(consume);
+            }
+            m_push_events.wait(events, std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief Close the queue, waking every waiting producer and consumer.
+     *        Queued elements may still be popped.
+     */
+    void close()
+    {
+        m_closed.store(true, std::memory_order_release);
+        m_push_events.fetch_add(1, std::memory_order_release);
+        m_push_events.notify_all();
+        m_pop_events.fetch_add(1, std::memory_order_release);
+        m_pop_events.notify_all();
+    }
+
+    /**
+     * @brief Get the number of slots
+     * @return Queue capacity
+     */
+    std::size_t capacity() const noexcept
+    {
+        return m_mask + 1;
+    }
+
+    /**
+     * @brief Get the cumulative queue counters
+     * @return Snapshot of the pushed, popped and dropped counts
+     */
+    queue_stats stats() const noexcept
+    {
+        return queue_stats{
+            m_pushed.load(std::memory_order_relaxed),
+            m_popped.load(std::memory_order_relaxed),
+            m_dropped.load(std::memory_order_relaxed)
+        };
+    }
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    struct cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    const std::size_t m_mask;
+    std::unique_ptr<cell[]> m_cells;
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_enqueue_pos{ 0 };
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_dequeue_pos{ 0 };
+    alignas(CACHE_LINE) std::atomic<uint32_t> m_push_events{ 0 };
+    alignas(CACHE_LINE) std::atomic<uint32_t> m_pop_events{ 0 };
+    std::atomic_bool m_closed{ false };
+    std::atomic<uint64_t> m_pushed{ 0 };
+    std::atomic<uint64_t> m_popped{ 0 };
+    std::atomic<uint64_t> m_dropped{ 0 };
+
+}; // end class bounded_queue
+
+} // end namespace vrtgen::io
@@ -0,0 +1,328 @@
+/*
+ * Copyright (C) 2026 Geon Technologies, LLC
+ *
+ * This file is part of vrtgen.
+ *
+ * vrtgen is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * vrtgen is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <linux/filter.h>
+#include <linux/if_packet.h>
+#include <net/ethernet.h>
+#include <net/if.h>
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <vrtgen/socket/udp.hpp>
+
+namespace vrtgen::io {
+
+/**
+ * @class packet_ring
+ * @brief Capture UDP datagrams from a network interface through a TPACKET_V3 ring
+ *
+ * Opens an AF_PACKET socket on an interface and maps a ring of blocks shared
+ * with the kernel. The kernel fills each block with many frames before
+ * handing it over, so a whole block of datagrams is consumed without any
+ * system calls or copies. A classic BPF filter restricts capture to IPv4 UDP
+ * datagrams addressed to the configured ports.
+ *
+ * Datagrams are captured in addition to, not instead of, delivery to any
+ * socket bound to the port. Requires CAP_NET_RAW. A ring is not thread-safe
+ * and must be driven from a single thread at a time.
+ */
+class packet_ring
+{
+public:
+    using endpoint_type = socket::endpoint::udp::v4;
+    using time_point = std::chrono::system_clock::time_point;
+
+    static constexpr std::size_t MAX_PORTS = 249; /**< Most ports one filter can compare; its jump offsets are 8 bits */
+
+    /**
+     * @brief Constructor
+     * @param interface Name of the interface to capture on, e.g. "eth0" or "lo"
+     * @param ports UDP destination ports to capture; between 1 and MAX_PORTS
+     * @param block_size Size of each ring block in bytes; must be a multiple of the page size
+     * @param block_count Number of blocks in the ring
+     * @param block_timeout Time after which the kernel hands over a partially filled block
+     * @throw std::runtime_error Failed to create, configure or map the ring
+     */
+    packet_ring(const std::string& interface,
+                const std::vector<uint16_t>& ports,
+                const std::size_t block_size = 1 << 22,
+                const std::size_t block_count = 64,
+                const std::chrono::milliseconds block_timeout = std::chrono::milliseconds{ 10 }) :
+        m_block_size(block_size),
+        m_block_count(block_count)
+    {
+        // Protocol 0 receives nothing until bind(), so the ring and filter are
+        // in place before the first frame arrives
+        m_fd = ::socket(AF_PACKET, SOCK_RAW, 0);
+        if (m_fd < 0) {
+            throw std::runtime_error(std::string("Failed to create packet socket: ") + strerror(errno));
+        }
+        try {
+            m_configure(interface, ports, block_timeout);
+        } catch (...) {
+            m_close();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Destructor.
+     *        Unmaps the ring and closes the socket.
+     */
+    ~packet_ring()
+    {
+        m_close();
+    }
+
+    packet_ring(const packet_ring&) = delete;
+    packet_ring& operator=(const packet_ring&) = delete;
+
+    /**
+     * @brief Wait for captured datagrams and invoke a handler for each
+     * @param handler Function called as handler(std::span<const uint8_t>, const endpoint_type&)
+     *                or handler(std::span<const uint8_t>, const endpoint_type&, time_point)
+     *                with the UDP payload, source endpoint and kernel capture time
+     * @param timeout Maximum time to wait for a block
+     * @return Number of datagrams handled, 0 on timeout, otherwise -1 for error
+     *
+     * Every block the kernel has handed over is consumed in one call. The span
+     * points into the ring and is only valid for the duration of the call.
+     */
+    template <class F>
+    int receive(F&& handler, const std::chrono::milliseconds timeout)
+    {
+        if (!m_block_ready(m_block)) {
+            pollfd fds{ m_fd, POLLIN | POLLERR, 0 };
+            auto res = poll(&fds, 1, static_cast<int>(timeout.count()));
+            if (res <= 0) {
+                return res;
+            }
+        }
+        auto handled = 0;
+        while (m_block_ready(m_block)) {
+            auto block = m_block_desc(m_block);
+            auto frame = reinterpret_cast<uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+            for (auto i = uint32_t{}; i < block->hdr.bh1.num_pkts; ++i) {
+                auto header = reinterpret_cast<const tpacket3_hdr*>(frame);
+                if (m_handle_frame(frame + header->tp_mac, header->tp_snaplen, header, handler)) {
+                    ++handled;
+                }
+                frame += header->tp_next_offset;
+            }
+            // Hand the block back to the kernel only after every frame in it is handled
+            std::atomic_ref<uint32_t>(block->hdr.bh1.block_status).store(TP_STATUS_KERNEL, std::memory_order_release);
+            m_block = (m_block + 1) % m_block_count;
+        }
+        return handled;
+    }
+
+    /**
+     * @brief Get the socket statistics and reset them
+     * @return Number of frames captured and dropped since the last call
+     */
+    tpacket_stats_v3 stats()
+    {
+        tpacket_stats_v3 stats{};
+        socklen_t len = sizeof(stats);
+        getsockopt(m_fd, SOL_PACKET, PACKET_STATISTICS, &stats, &len);
+        return stats;
+    }
+
+    /**
+     * @brief Get the native packet socket
+     * @return The packet socket file descriptor, e.g. for registering with a reactor
+     */
+    int native_handle() const noexcept
+    {
+        return m_fd;
+    }
+
+private:
+    static constexpr std::size_t FRAME_SIZE = 2048; /**< Nominal frame size; V3 frames are variable length */
+    static constexpr uint32_t SNAP_LENGTH = 65535;
+
+    /**
+     * @brief Set up the ring, filter and interface binding
+     */
+    void m_configure(const std::string& interface, const std::vector<uint16_t>& ports,
+                     const std::chrono::milliseconds block_timeout)
+    {
+        const auto fail = [](const std::string& what)
+        {
+            throw std::runtime_error("Failed to " + what + ": " + strerror(errno));
+        };
+        const auto index = if_nametoindex(interface.c_str());
+        if (index == 0) {
+            fail("find interface " + interface);
+        }
+        int version = TPACKET_V3;
+        if (setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) != 0) {
+            fail("select TPACKET_V3");
+        }
+        // Loopback delivers every datagram twice, once outgoing and once incoming
+        int ignore = 1;
+        setsockopt(m_fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &ignore, sizeof(ignore));
+        m_attach_filter(ports);
+
+        tpacket_req3 request{};
+        request.tp_block_size = static_cast<unsigned>(m_block_size);
+        request.tp_block_nr = static_cast<unsigned>(m_block_count);
+        request.tp_frame_size = FRAME_SIZE;
+        request.tp_frame_nr = static_cast<unsigned>(m_block_size * m_block_count / FRAME_SIZE);
+        request.tp_retire_blk_tov = static_cast<unsigned>(block_timeout.count());
+        if (setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &request, sizeof(request)) != 0) {
+            fail("create packet ring");
+        }
+        auto map = mmap(nullptr, m_block_size * m_block_count, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, m_fd, 0);
+        if (map == MAP_FAILED) {
+            fail("map packet ring");
+        }
+        m_map = static_cast<uint8_t*>(map);
+
+        sockaddr_ll address{};
+        address.sll_family = AF_PACKET;
+        address.sll_protocol = htons(ETH_P_IP);
+        address.sll_ifindex = static_cast<int>(index);
+        if (::bind(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            fail("bind packet socket to " + interface);
+        }
+    }
+
+    /**
+     * @brief Attach a filter accepting unfragmented IPv4 UDP datagrams to the given ports
+     */
+    void m_attach_filter(const std::vector<uint16_t>& ports)
+    {
+        // The longest jump skips every port comparison and five more instructions
+        static_assert(MAX_PORTS + 6 <= UINT8_MAX);
+        if (ports.empty() || ports.size() > MAX_PORTS) {
+            errno = EINVAL;
+            throw std::runtime_error("Packet ring needs between 1 and " + std::to_string(MAX_PORTS) + " ports");
+        }
+        const auto count = static_cast<uint8_t>(ports.size());
+        // Jump offsets are relative to the next instruction; drop is at the end
+        // of the port comparisons, accept right after it
+        std::vector<sock_filter> program{
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12),                               // Ethertype
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ETHERTYPE_IP, 0, static_cast<uint8_t>(count + 6)),
+            BPF_STMT(BPF_LD | BPF_B | BPF_ABS, ETH_HLEN + 9),                     // IP protocol
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 0, static_cast<uint8_t>(count + 4)),
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, ETH_HLEN + 6),                     // Fragment offset
+            BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x1FFF, static_cast<uint8_t>(count + 2), 0),
+            BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, ETH_HLEN),                        // X = IP header length
+            BPF_STMT(BPF_LD | BPF_H | BPF_IND, ETH_HLEN + 2),                     // UDP destination port
+        };
+        for (auto i = uint8_t{}; i < count; ++i) {
+            program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ports[i], static_cast<uint8_t>(count - i), 0));
+        }
+        program.push_back(BPF_STMT(BPF_RET | BPF_K, 0));
+        program.push_back(BPF_STMT(BPF_RET | BPF_K, SNAP_LENGTH));
+        sock_fprog fprog{ static_cast<unsigned short>(program.size()), program.data() };
+        if (setsockopt(m_fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) != 0) {
+            throw std::runtime_error(std::string("Failed to attach packet filter: ") + strerror(errno));
+        }
+    }
+
+    /**
+     * @brief Extract the UDP payload of a captured frame and pass it to the handler
+     * @return true if the frame held a complete UDP datagram, otherwise false
+     */
+    template <class F>
+    bool m_handle_frame(const uint8_t* frame, const std::size_t length, const tpacket3_hdr* header, F& handler)
+    {
+        if (length < ETH_HLEN + sizeof(iphdr)) {
+            return false;
+        }
+        iphdr ip;
+        std::memcpy(&ip, frame + ETH_HLEN, sizeof(ip));
+        const auto ip_length = std::min<std::size_t>(ntohs(ip.tot_len), length - ETH_HLEN);
+        const auto ip_header_length = std::size_t{ ip.ihl } * 4;
+        // Reject malformed headers before they can underflow the lengths below
+        if (ip.ihl < 5 || ip_length < ip_header_length + sizeof(udphdr)) {
+            return false;
+        }
+        udphdr udp;
+        std::memcpy(&udp, frame + ETH_HLEN + ip_header_length, sizeof(udp));
+        if (ntohs(udp.len) < sizeof(udp)) {
+            return false;
+        }
+        const auto payload_offset = ETH_HLEN + ip_header_length + sizeof(udp);
+        // Ethernet padding can follow short datagrams, so trust the UDP length
+        const auto payload_length = std::min<std::size_t>(ntohs(udp.len), ip_length - ip_header_length) - sizeof(udp);
+        const auto payload = std::span<const uint8_t>{ frame + payload_offset, payload_length };
+
+        endpoint_type source;
+        source.sockaddr().sin_addr.s_addr = ip.saddr;
+        source.sockaddr().sin_port = udp.source;
+        if constexpr (std::is_invocable_v<F, std::span<const uint8_t>, const endpoint_type&, time_point>) {
+            const auto captured = time_point{ std::chrono::duration_cast<time_point::duration>(
+                std::chrono::seconds{ header->tp_sec } + std::chrono::nanoseconds{ header->tp_nsec }) };
+            handler(payload, source, captured);
+        } else {
+            handler(payload, source);
+        }
+        return true;
+    }
+
+    tpacket_block_desc* m_block_desc(const std::size_t index) const noexcept
+    {
+        return reinterpret_cast<tpacket_block_desc*>(m_map + index * m_block_size);
+    }
+
+    bool m_block_ready(const std::size_t index) const noexcept
+    {
+        auto& status = m_block_desc(index)->hdr.bh1.block_status;
+        return std::atomic_ref<uint32_t>(status).load(std::memory_order_acquire) & TP_STATUS_USER;
+    }
+
+    void m_close() noexcept
+    {
+        if (m_map != nullptr) {
+            munmap(m_map, m_block_size * m_block_count);
+            m_map = nullptr;
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    int m_fd{ -1 };
+    uint8_t* m_map{ nullptr };
+    std::size_t m_block_size;
+    std::size_t m_block_count;
+    std::size_t m_block{ 0 }; /**< Next block to consume */
+
+}; // end class packet_ring
+
+} // end namespace vrtgen::io
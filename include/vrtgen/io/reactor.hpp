@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2026 Geon Technologies, LLC
+ *
+ * This file is part of vrtgen.
+ *
+ * vrtgen is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * vrtgen is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace vrtgen::io {
+
+/**
+ * @class reactor
+ * @brief epoll event loop servicing many file descriptors from a pool of threads
+ *
+ * Handlers are called when their file descriptor becomes readable and are
+ * expected to drain it (read until EAGAIN) before returning. Registrations
+ * are one-shot and re-armed after the handler returns, so a handler never
+ * runs on two threads at once, while different file descriptors may be
+ * serviced concurrently when more than one thread is used. An exception
+ * thrown by a handler is caught, reported on std::cerr and counted by
+ * handler_errors(); the file descriptor stays registered.
+ *
+ * Stopping the reactor wakes every thread through an eventfd, so shutdown
+ * does not wait on socket receive timeouts.
+ */
+class reactor
+{
+public:
+    using handler_type = std::function<void()>;
+
+    /**
+     * @brief Constructor
+     * @param threads Number of threads servicing events
+     * @throw std::runtime_error Failed to create epoll or eventfd descriptors
+     */
+    explicit reactor(const std::size_t threads = 1)
+    {
+        m_epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (m_epoll < 0) {
+            throw std::runtime_error(std::string("Failed to create epoll instance: ") + strerror(errno));
+        }
+        m_wakeup = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (m_wakeup < 0) {
+            auto err = std::string(strerror(errno));
+            ::close(m_epoll);
+            throw std::runtime_error("Failed to create eventfd: " + err);
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = WAKEUP_ID;
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &event);
+        for (auto i = std::size_t{}; i < std::max<std::size_t>(threads, 1); ++i) {
+            m_threads.emplace_back(&reactor::m_run, this);
+        }
+    }
+
+    reactor(const reactor&) = delete;
+    reactor& operator=(const reactor&) = delete;
+
+    /**
+     * @brief Destructor.
+     *        Stops and joins all threads.
+     */
+    ~reactor()
+    {
+        stop();
+        ::close(m_wakeup);
+        ::close(m_epoll);
+    }
+
+    /**
+     * @brief Register a file descriptor for read events
+     * @param fd File descriptor to watch, should be non-blocking
+     * @param handler Function called on a reactor thread when fd is readable;
+     *                exceptions it throws do not escape the reactor thread
+     * @return true on success, otherwise false
+     */
+    bool add(const int fd, handler_type handler)
+    {
+        std::lock_guard lock(m_mutex);
+        auto entry = std::make_shared<registration>();
+        entry->fd = fd;
+        entry->handler = std::move(handler);
+        entry->id = m_next_id++;
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLONESHOT;
+        event.data.u64 = entry->id;
+        if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) < 0) {
+            return false;
+        }
+        m_registrations[fd] = entry;
+        m_ids[entry->id] = entry;
+        return true;
+    }
+
+    /**
+     * @brief Deregister a file descriptor
+     * @param fd File descriptor previously passed to add()
+     * @return true if fd was registered, otherwise false
+     *
+     * Waits for a running handler to return unless called from that handler,
+     * after which the handler is never called again.
+     */
+    bool remove(const int fd)
+    {
+        std::unique_lock lock(m_mutex);
+        auto iter = m_registrations.find(fd);
+        if (iter == m_registrations.end()) {
+            return false;
+        }
+        auto entry = iter->second;
+        m_registrations.erase(iter);
+        m_ids.erase(entry->id);
+        entry->removed = true;
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+        m_idle.wait(lock, [&entry]
+        {
+            return !entry->running || entry->runner == std::this_thread::get_id();
+        });
+        return true;
+    }
+
+    /**
+     * @brief Stop servicing events and join all threads
+     */
+    void stop()
+    {
+        const uint64_t value = 1;
+        // The eventfd is never read, so it stays readable and wakes every thread
+        [[maybe_unused]] auto res = ::write(m_wakeup, &value, sizeof(value));
+        for (auto& thread : m_threads) {
+            if (thread.joinable() && thread.get_id() != std::this_thread::get_id()) {
+                thread.join();
+            }
+        }
+    }
+
+    /**
+     * @brief Get the number of threads servicing events
+     * @return Thread count
+     */
+    std::size_t thread_count() const noexcept
+    {
+        return m_threads.size();
+    }
+
+    /**
+     * @brief Get the number of exceptions thrown by handlers
+     * @return Error count
+     */
+    uint64_t handler_errors() const noexcept
+    {
+        return m_handler_errors.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint64_t WAKEUP_ID = 0;
+    static constexpr int MAX_EVENTS = 64;
+
+    struct registration
+    {
+        int fd{ -1 };
+        uint64_t id{};
+        handler_type handler;
+        bool running{ false };
+        bool removed{ false };
+        std::thread::id runner;
+    };
+
+    int m_epoll{ -1 };
+    int m_wakeup{ -1 };
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_idle;
+    std::unordered_map<int, std::shared_ptr<registration>> m_registrations;
+    std::unordered_map<uint64_t, std::shared_ptr<registration>> m_ids;
+    uint64_t m_next_id{ WAKEUP_ID + 1 };
+    std::atomic<uint64_t> m_handler_errors{ 0 };
+
+    void m_run()
+    {
+        epoll_event events[MAX_EVENTS];
+        while (true) {
+            auto count = epoll_wait(m_epoll, events, MAX_EVENTS, -1);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+            for (auto i = 0; i < count; ++i) {
+                if (events[i].data.u64 == WAKEUP_ID) {
+                    return;
+                }
+                std::shared_ptr<registration> entry;
+                {
+                    std::lock_guard lock(m_mutex);
+                    auto iter = m_ids.find(events[i].data.u64);
+                    if (iter == m_ids.end()) {
+                        continue;
+                    }
+                    entry = iter->second;
+                    entry->running = true;
+                    entry->runner = std::this_thread::get_id();
+                }
+                try {
+                    entry->handler();
+                } catch (const std::exception& e) {
+                    // Escaping would terminate the process and leave the entry marked running
+                    m_handler_errors.fetch_add(1, std::memory_order_relaxed);
+                    std::cerr << "Reactor handler for fd " << entry->fd << " failed: " << e.what() << std::endl;
+                } catch (...) {
+                    m_handler_errors.fetch_add(1, std::memory_order_relaxed);
+                    std::cerr << "Reactor handler for fd " << entry->fd << " failed" << std::endl;
+                }
+                {
+                    std::lock_guard lock(m_mutex);
+                    entry->running = false;
+                    if (!entry->removed) {
+                        epoll_event event{};
+                        event.events = EPOLLIN | EPOLLONESHOT;
+                        event.data.u64 = entry->id;
+                        epoll_ctl(m_epoll, EPOLL_CTL_MOD, entry->fd, &event);
+                    }
+                }
+                m_idle.notify_all();
+            }
+        }
+    }
+
+}; // end class reactor
+
+} // end namespace vrtgen::io
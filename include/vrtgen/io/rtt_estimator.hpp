@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Geon Technologies, LLC
+ *
+ * This file is part of vrtgen.
+ *
+ * vrtgen is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * vrtgen is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace vrtgen::io {
+
+/**
+ * @class rtt_estimator
+ * @brief Round-trip time estimator and retransmission timeout (RFC 6298)
+ *
+ * Keeps a smoothed round-trip time (SRTT) and its mean deviation (RTTVAR)
+ * from measured samples and derives the retransmission timeout
+ * RTO = SRTT + 4 * RTTVAR, clamped to [min_rto, max_rto]. Samples should
+ * only be taken from exchanges that were not retransmitted (Karn's
+ * algorithm), since an acknowledgement of a retransmission cannot be matched
+ * to one transmission. Not thread-safe.
+ */
+class rtt_estimator
+{
+public:
+    using duration = std::chrono::nanoseconds;
+
+    /**
+     * @brief Constructor
+     * @param initial_rto Timeout used until the first sample
+     * @param min_rto Lower bound of the timeout, at least the timer granularity
+     * @param max_rto Upper bound of the timeout, including backoff
+     */
+    explicit rtt_estimator(const duration initial_rto = std::chrono::seconds{ 1 },
+                           const duration min_rto = std::chrono::milliseconds{ 1 },
+                           const duration max_rto = std::chrono::seconds{ 60 }) :
+        m_min_rto(min_rto),
+        m_max_rto(std::max(max_rto, min_rto)),
+        m_rto(std::clamp(initial_rto, m_min_rto, m_max_rto))
+    {
+    }
+
+    /**
+     * @brief Add a round-trip time measurement
+     * @param rtt Time from sending a request to receiving its reply
+     */
+    void sample(const duration rtt) noexcept
+    {
+        if (m_samples == 0) {
+            m_srtt = rtt;
+            m_rttvar = rtt / 2;
+        } else {
+            const auto error = m_srtt > rtt ? m_srtt - rtt : rtt - m_srtt;
+            m_rttvar = (3 * m_rttvar + error) / 4;
+            m_srtt = (7 * m_srtt + rtt) / 8;
+        }
+        ++m_samples;
+        m_rto = std::clamp(m_srtt + 4 * m_rttvar, m_min_rto, m_max_rto);
+    }
+
+    /**
+     * @brief Get the retransmission timeout for a transmission
+     * @param retransmissions Number of times the request has already been retransmitted
+     * @return RTO doubled for each retransmission (exponential backoff), at most max_rto
+     */
+    duration rto(const unsigned retransmissions = 0) const noexcept
+    {
+        auto timeout = m_rto;
+        for (auto i = 0U; i < retransmissions && timeout < m_max_rto; ++i) {
+            timeout *= 2;
+        }
+        return std::min(timeout, m_max_rto);
+    }
+
+    /**
+     * @brief Get the smoothed round-trip time, zero before the first sample
+     */
+    duration srtt() const noexcept
+    {
+        return m_srtt;
+    }
+
+    /**
+     * @brief Get the round-trip time variation, zero before the first sample
+     */
+    duration rttvar() const noexcept
+    {
+        return m_rttvar;
+    }
+
+    /**
+     * @brief Get the number of samples taken
+     */
+    std::size_t samples() const noexcept
+    {
+        return m_samples;
+    }
+
+private:
+    duration m_min_rto;
+    duration m_max_rto;
+    duration m_rto;
+    duration m_srtt{};
+    duration m_rttvar{};
+    std::size_t m_samples{ 0 };
+};
+
+} // end namespace vrtgen::io
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Geon Technologies, LLC
+ *
+ * This file is part of vrtgen.
+ *
+ * vrtgen is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * vrtgen is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace vrtgen::io {
+
+/**
+ * @class timer_wheel
+ * @brief Hashed timing wheel for expiring large numbers of timeouts
+ * @tparam Key Type identifying each timer
+ *
+ * Timers are hashed into slots by deadline, so scheduling is constant time
+ * and advancing only visits the slots that have elapsed. Timers fire at most
+ * one tick late. Deadlines further out than one revolution stay in their
+ * slot until a later pass reaches them. Timers cannot be cancelled; the
+ * expiry callback should ignore keys that are no longer of interest.
+ * Not thread-safe.
+ */
+template <class Key>
+class timer_wheel
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Constructor
+     * @param tick Time covered by each slot, the expiry granularity
+     * @param slots Number of slots in one revolution of the wheel
+     * @param start Time at which the wheel starts turning
+     */
+    explicit timer_wheel(const clock::duration tick = std::chrono::milliseconds{ 10 },
+                         const std::size_t slots = 256,
+                         const clock::time_point start = clock::now()) :
+        m_slots(slots == 0 ? 1 : slots),
+        m_tick(tick <= clock::duration::zero() ? clock::duration{ 1 } : tick),
+        m_slot_start(start)
+    {
+    }
+
+    /**
+     * @brief Schedule a timer
+     * @param key Key passed to the expiry callback
+     * @param deadline Time at which the timer expires; past deadlines expire on the next advance
+     */
+    void schedule(const Key& key, const clock::time_point deadline)
+    {
+        auto ticks = std::size_t{};
+        if (deadline > m_slot_start) {
+            ticks = static_cast<std::size_t>((deadline - m_slot_start) / m_tick);
+        }
+        m_slots[(m_cursor + ticks) % m_slots.size()].push_back({ key, deadline });
+        ++m_size;
+    }
+
+    /**
+     * @brief Expire the timers of every slot that has elapsed
+     * @param now Current time
+     * @param on_expire Callable invoked as on_expire(key) for each expired timer; may schedule new timers
+     * @return Number of timers expired
+     */
+    template <class F>
+    std::size_t advance(const clock::time_point now, F&& on_expire)
+    {
+        auto expired = std::size_t{};
+        // A long gap only needs one pass over the wheel; later revolutions are caught by the deadline check
+        auto remaining = m_slots.size();
+        while (m_slot_start + m_tick <= now && remaining > 0) {
+            auto& slot = m_slots[m_cursor];
+            for (auto i = std::size_t{}; i < slot.size();) {
+                if (slot[i].deadline <= now) {
+                    auto key = slot[i].key;
+                    slot[i] = std::move(slot.back());
+                    slot.pop_back();
+                    --m_size;
+                    ++expired;
+                    on_expire(key);
+                } else {
+                    ++i;
+                }
+            }
+            m_cursor = (m_cursor + 1) % m_slots.size();
+            m_slot_start += m_tick;
+            --remaining;
+        }
+        if (m_slot_start + m_tick <= now) {
+            // Skip the rest of the gap, keeping the cursor in step so pending timers stay in their slots
+            const auto skipped = (now - m_slot_start) / m_tick;
+            m_slot_start += skipped * m_tick;
+            m_cursor = (m_cursor + static_cast<std::size_t>(skipped)) % m_slots.size();
+        }
+        return expired;
+    }
+
+    /**
+     * @brief Get the number of scheduled timers
+     */
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Get whether no timers are scheduled
+     */
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+private:
+    struct entry
+    {
+        Key key;
+        clock::time_point deadline;
+    };
+
+    std::vector<std::vector<entry>> m_slots;
+    clock::duration m_tick;
+    clock::time_point m_slot_start; // Start of the slot at m_cursor
+    std::size_t m_cursor{ 0 };
+    std::size_t m_size{ 0 };
+};
+
+} // end namespace vrtgen::io
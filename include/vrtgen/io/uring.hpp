@@ -0,0 +1,634 @@
+/*
+ * Copyright (C) 2026 Geon Technologies, LLC
+ *
+ * This file is part of vrtgen.
+ *
+ * vrtgen is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * vrtgen is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+
+// Multishot recvmsg and fixed-buffer sends both arrived in Linux 6.0
+#if defined(IORING_RECV_MULTISHOT) && defined(IORING_RECVSEND_FIXED_BUF)
+#define VRTGEN_HAS_IO_URING 1
+#else
+#define VRTGEN_HAS_IO_URING 0
+#endif
+
+#if VRTGEN_HAS_IO_URING
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <vrtgen/socket/udp.hpp>
+
+namespace vrtgen::io {
+
+namespace detail {
+
+/**
+ * @class uring
+ * @brief Minimal io_uring instance driven through raw system calls
+ *
+ * Owns the ring file descriptor and the shared submission and completion
+ * queue mappings. A ring is not thread-safe and must be driven from a single
+ * thread at a time.
+ */
+class uring
+{
+public:
+    /**
+     * @brief Constructor
+     * @param entries Number of submission queue entries
+     * @throw std::runtime_error Failed to create or map the ring
+     */
+    explicit uring(const unsigned entries)
+    {
+        io_uring_params params{};
+        // Multishot requests post many completions per submission, so give
+        // the completion queue some headroom
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = entries * 8;
+        m_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (m_fd < 0) {
+            throw std::runtime_error(std::string("Failed to create io_uring: ") + strerror(errno));
+        }
+        m_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        m_sq_ptr = mmap(nullptr, m_sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+        m_cq_ptr = mmap(nullptr, m_cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+        auto sqes = mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+        if (m_sq_ptr == MAP_FAILED || m_cq_ptr == MAP_FAILED || sqes == MAP_FAILED) {
+            auto err = std::string(strerror(errno));
+            release(sqes);
+            throw std::runtime_error("Failed to map io_uring queues: " + err);
+        }
+        auto sq = static_cast<uint8_t*>(m_sq_ptr);
+        m_sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sq_entries = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+        m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+        auto cq = static_cast<uint8_t*>(m_cq_ptr);
+        m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        m_sqe_tail = *m_sq_tail;
+    }
+
+    uring(const uring&) = delete;
+    uring& operator=(const uring&) = delete;
+
+    /**
+     * @brief Destructor.
+     *        Unmaps the queues and closes the ring.
+     */
+    ~uring()
+    {
+        close();
+    }
+
+    /**
+     * @brief Unmap the queues and close the ring.
+     *        Safe to call more than once; the kernel drops its references to
+     *        registered buffers once the ring is closed.
+     */
+    void close() noexcept
+    {
+        release(m_sqes);
+        m_sqes = nullptr;
+    }
+
+    /**
+     * @brief Get the ring file descriptor
+     * @return The io_uring file descriptor
+     */
+    int fd() const noexcept
+    {
+        return m_fd;
+    }
+
+    /**
+     * @brief Get the next free submission queue entry
+     * @return Pointer to a zeroed entry, or nullptr if the submission queue is full
+     *
+     * Entries are not visible to the kernel until the next call to enter().
+     */
+    io_uring_sqe* get_sqe() noexcept
+    {
+        const auto head = std::atomic_ref<unsigned>(*m_sq_head).load(std::memory_order_acquire);
+        if (m_sqe_tail - head >= m_sq_entries) {
+            return nullptr;
+        }
+        const auto index = m_sqe_tail & m_sq_mask;
+        auto sqe = &m_sqes[index];
+        std::memset(sqe, 0, sizeof(io_uring_sqe));
+        m_sq_array[index] = index;
+        ++m_sqe_tail;
+        ++m_pending;
+        return sqe;
+    }
+
+    /**
+     * @brief Submit pending entries and optionally wait for completions
+     * @param min_complete Number of completions to wait for
+     * @param timeout Maximum time to wait for completions
+     * @return Number of entries submitted on success, otherwise -1 with errno set
+     *
+     * Returns -1 with errno set to ETIME if the timeout expired before
+     * min_complete completions were available.
+     */
+    int enter(const unsigned min_complete, const std::chrono::nanoseconds timeout = {})
+    {
+        std::atomic_ref<unsigned>(*m_sq_tail).store(m_sqe_tail, std::memory_order_release);
+        if (m_pending == 0 && min_complete == 0) {
+            return 0;
+        }
+        auto flags = 0u;
+        io_uring_getevents_arg arg{};
+        __kernel_timespec ts{};
+        if (min_complete > 0) {
+            const auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+            ts.tv_sec = secs.count();
+            ts.tv_nsec = (timeout - secs).count();
+            arg.ts = reinterpret_cast<uint64_t>(&ts);
+            flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+        }
+        auto res = static_cast<int>(syscall(__NR_io_uring_enter, m_fd, m_pending, min_complete, flags, &arg, sizeof(arg)));
+        if (res > 0) {
+            m_pending -= std::min(m_pending, static_cast<unsigned>(res));
+        }
+        return res;
+    }
+
+    /**
+     * @brief Consume all available completion queue entries
+     * @param func Function called with each completion queue entry
+     * @return Number of completions consumed
+     */
+    template <class F>
+    unsigned for_each_cqe(F&& func)
+    {
+        auto head = *m_cq_head;
+        const auto tail = std::atomic_ref<unsigned>(*m_cq_tail).load(std::memory_order_acquire);
+        auto count = 0u;
+        while (head != tail) {
+            func(m_cqes[head & m_cq_mask]);
+            ++head;
+            ++count;
+        }
+        std::atomic_ref<unsigned>(*m_cq_head).store(head, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Register resources with the ring
+     * @param opcode io_uring_register operation
+     * @param arg Operation argument
+     * @param nr_args Number of arguments
+     * @return 0 on success, otherwise -1 with errno set
+     */
+    int register_op(const unsigned opcode, const void* arg, const unsigned nr_args)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_register, m_fd, opcode, arg, nr_args));
+    }
+
+private:
+    int m_fd{ -1 };
+    void* m_sq_ptr{ MAP_FAILED };
+    void* m_cq_ptr{ MAP_FAILED };
+    std::size_t m_sq_size{};
+    std::size_t m_cq_size{};
+    std::size_t m_sqes_size{};
+    unsigned* m_sq_head{ nullptr };
+    unsigned* m_sq_tail{ nullptr };
+    unsigned* m_sq_array{ nullptr };
+    unsigned m_sq_mask{};
+    unsigned m_sq_entries{};
+    unsigned m_sqe_tail{};
+    unsigned m_pending{};
+    io_uring_sqe* m_sqes{ nullptr };
+    unsigned* m_cq_head{ nullptr };
+    unsigned* m_cq_tail{ nullptr };
+    unsigned m_cq_mask{};
+    io_uring_cqe* m_cqes{ nullptr };
+
+    void release(void* sqes)
+    {
+        if (sqes != nullptr && sqes != MAP_FAILED) {
+            munmap(sqes, m_sqes_size);
+        }
+        if (m_cq_ptr != MAP_FAILED) {
+            munmap(m_cq_ptr, m_cq_size);
+            m_cq_ptr = MAP_FAILED;
+        }
+        if (m_sq_ptr != MAP_FAILED) {
+            munmap(m_sq_ptr, m_sq_size);
+            m_sq_ptr = MAP_FAILED;
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+}; // end class uring
+
+} // end namespace detail
+
+/**
+ * @class uring_datagram
+ * @brief io_uring I/O backend for a datagram socket
+ *
+ * Receives through a single multishot recvmsg request that the kernel fills
+ * from a ring of provided buffers, so a burst of datagrams costs one system
+ * call to reap rather than one per datagram. Sends are copied into buffers
+ * registered with the kernel up front and queued until submit() is called,
+ * which hands the whole batch to the kernel at once.
+ *
+ * Receive and send use independent rings: one thread may call receive()
+ * while another calls send_to()/submit(), but each side is single-threaded.
+ * Requires Linux 6.0 or later.
+ */
+template <int domain>
+class uring_datagram
+{
+public:
+    using socket_type = socket::datagram_socket<domain>;
+    using endpoint_type = typename socket_type::endpoint_type;
+    using time_point = typename socket_type::time_point;
+
+    /**
+     * @brief Constructor
+     * @param socket Bound datagram socket to perform I/O on; must outlive this object
+     * @param buffer_count Number of receive buffers (rounded up to a power of 2)
+     * @param buffer_size Size of each receive and send buffer in bytes
+     * @param send_slots Number of registered send buffers
+     * @throw std::runtime_error io_uring is unavailable or resources could not be registered
+     */
+    explicit uring_datagram(socket_type& socket,
+                            const std::size_t buffer_count = 256,
+                            const std::size_t buffer_size = 65536 + RECV_OVERHEAD,
+                            const std::size_t send_slots = 64) :
+        m_socket(socket),
+        m_recv_ring(RING_ENTRIES),
+        m_send_ring(static_cast<unsigned>(std::bit_ceil(send_slots))),
+        m_buffer_count(std::bit_ceil(buffer_count)),
+        m_buffer_size(buffer_size),
+        m_recv_pool(m_buffer_count * buffer_size),
+        m_send_pool(send_slots * buffer_size),
+        m_send_dest(send_slots)
+    {
+        // Provided buffer ring for multishot receive
+        m_buf_ring_size = m_buffer_count * sizeof(io_uring_buf);
+        auto ring_mem = mmap(nullptr, m_buf_ring_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+        if (ring_mem == MAP_FAILED) {
+            throw std::runtime_error(std::string("Failed to allocate io_uring buffer ring: ") + strerror(errno));
+        }
+        // Index the ring as a plain io_uring_buf array: the flexible array in
+        // io_uring_buf_ring is offset by an empty struct when compiled as C++
+        m_buf_ring = static_cast<io_uring_buf*>(ring_mem);
+        io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast<uint64_t>(m_buf_ring);
+        reg.ring_entries = static_cast<uint32_t>(m_buffer_count);
+        reg.bgid = BUFFER_GROUP;
+        if (m_recv_ring.register_op(IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+            auto err = std::string(strerror(errno));
+            m_recv_ring.close();
+            munmap(m_buf_ring, m_buf_ring_size);
+            throw std::runtime_error("Failed to register io_uring buffer ring: " + err);
+        }
+        for (auto bid = std::size_t{}; bid < m_buffer_count; ++bid) {
+            add_buffer(static_cast<uint16_t>(bid));
+        }
+        publish_buffers();
+
+        // Fixed buffers for send
+        auto iovecs = std::vector<iovec>(send_slots);
+        for (auto slot = std::size_t{}; slot < send_slots; ++slot) {
+            iovecs[slot].iov_base = m_send_pool.data() + slot * m_buffer_size;
+            iovecs[slot].iov_len = m_buffer_size;
+            m_free_slots.push_back(static_cast<uint16_t>(slot));
+        }
+        if (m_send_ring.register_op(IORING_REGISTER_BUFFERS, iovecs.data(), static_cast<unsigned>(iovecs.size())) < 0) {
+            auto err = std::string(strerror(errno));
+            m_recv_ring.close();
+            m_send_ring.close();
+            munmap(m_buf_ring, m_buf_ring_size);
+            throw std::runtime_error("Failed to register io_uring send buffers: " + err);
+        }
+
+        // msghdr template for multishot recvmsg; only the name and control
+        // lengths are used by the kernel
+        m_recv_msg.msg_namelen = sizeof(typename endpoint_type::sockaddr_type);
+        m_recv_msg.msg_controllen = CONTROL_SIZE;
+    }
+
+    uring_datagram(const uring_datagram&) = delete;
+    uring_datagram& operator=(const uring_datagram&) = delete;
+
+    /**
+     * @brief Destructor.
+     *        Cancels the outstanding receive and waits briefly for in-flight sends.
+     */
+    ~uring_datagram()
+    {
+        using namespace std::chrono_literals;
+        if (m_recv_armed) {
+            if (auto sqe = m_recv_ring.get_sqe(); sqe != nullptr) {
+                sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                sqe->addr = RECV_TAG;
+                sqe->user_data = CANCEL_TAG;
+            }
+            auto deadline = std::chrono::steady_clock::now() + 100ms;
+            while (m_recv_armed && std::chrono::steady_clock::now() < deadline) {
+                m_recv_ring.enter(1, 10ms);
+                m_recv_ring.for_each_cqe([this](const io_uring_cqe& cqe)
+                {
+                    if (cqe.user_data == RECV_TAG && !(cqe.flags & IORING_CQE_F_MORE)) {
+                        m_recv_armed = false;
+                    }
+                });
+            }
+        }
+        auto deadline = std::chrono::steady_clock::now() + 100ms;
+        while (m_free_slots.size() < m_send_dest.size() && std::chrono::steady_clock::now() < deadline) {
+            submit();
+            m_send_ring.enter(1, 10ms);
+            reap_sends();
+        }
+        // Close the rings before releasing the buffer ring and pools they reference
+        m_recv_ring.close();
+        m_send_ring.close();
+        munmap(m_buf_ring, m_buf_ring_size);
+    }
+
+    /**
+     * @brief Wait for datagrams and invoke a handler for each
+     * @param handler Function called as handler(std::span<const uint8_t>, const endpoint_type&)
+     *                or handler(std::span<const uint8_t>, const endpoint_type&, time_point)
+     *                for every datagram received; the time_point is the kernel arrival
+     *                time if the socket has timestamps() enabled, otherwise the epoch
+     * @param timeout Maximum time to wait for the first datagram
+     * @return Number of datagrams handled, 0 on timeout, otherwise -1 for error
+     *
+     * Every datagram already queued is handled in one call. The span passed to
+     * the handler is only valid for the duration of the call.
+     */
+    template <class F>
+    int receive(F&& handler, const std::chrono::nanoseconds timeout)
+    {
+        if (!m_recv_armed) {
+            arm_receive();
+        }
+        if (m_recv_ring.enter(1, timeout) < 0 && errno != ETIME && errno != EINTR) {
+            return -1;
+        }
+        auto handled = 0;
+        auto error = 0;
+        endpoint_type endpoint;
+        m_recv_ring.for_each_cqe([&](const io_uring_cqe& cqe)
+        {
+            if (cqe.user_data != RECV_TAG) {
+                return;
+            }
+            if (!(cqe.flags & IORING_CQE_F_MORE)) {
+                m_recv_armed = false;
+            }
+            if (cqe.res < 0) {
+                // ENOBUFS only means the buffer ring ran dry; re-arming recovers
+                if (cqe.res != -ENOBUFS) {
+                    error = -cqe.res;
+                }
+                return;
+            }
+            if (!(cqe.flags & IORING_CQE_F_BUFFER)) {
+                return;
+            }
+            const auto bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            auto buffer = m_recv_pool.data() + bid * m_buffer_size;
+            const auto length = static_cast<std::size_t>(cqe.res);
+            const auto prefix = sizeof(io_uring_recvmsg_out) + m_recv_msg.msg_namelen + m_recv_msg.msg_controllen;
+            if (length >= prefix) {
+                io_uring_recvmsg_out out;
+                std::memcpy(&out, buffer, sizeof(out));
+                const auto namelen = std::min<std::size_t>(out.namelen, sizeof(typename endpoint_type::sockaddr_type));
+                std::memcpy(&endpoint.sockaddr(), buffer + sizeof(out), namelen);
+                endpoint.socklen() = static_cast<socklen_t>(namelen);
+                const auto payload_len = std::min<std::size_t>(out.payloadlen, length - prefix);
+                const auto payload = std::span<const uint8_t>{ buffer + prefix, payload_len };
+                // Copy the control messages out, they are not necessarily aligned in the buffer
+                auto arrival = time_point{};
+                if (out.controllen > 0) {
+                    alignas(cmsghdr) std::array<uint8_t, CONTROL_SIZE> control;
+                    const auto control_len = std::min<std::size_t>(out.controllen, CONTROL_SIZE);
+                    std::memcpy(control.data(), buffer + sizeof(out) + m_recv_msg.msg_namelen, control_len);
+                    msghdr msg{};
+                    msg.msg_control = control.data();
+                    msg.msg_controllen = control_len;
+                    arrival = m_socket.process_control(msg);
+                }
+                if constexpr (std::is_invocable_v<F, std::span<const uint8_t>, const endpoint_type&, time_point>) {
+                    handler(payload, endpoint, arrival);
+                } else {
+                    handler(payload, endpoint);
+                }
+                ++handled;
+            }
+            add_buffer(bid);
+        });
+        publish_buffers();
+        if (handled == 0 && error != 0) {
+            errno = error;
+            return -1;
+        }
+        return handled;
+    }
+
+    /**
+     * @brief Queue a datagram to be sent from a registered buffer
+     * @param data Message data, copied into a registered send buffer
+     * @param endpoint Destination endpoint for the message
+     * @return true if the message was queued, false if it is larger than a send buffer
+     *
+     * Queued messages are handed to the kernel by the next call to submit().
+     * If every send buffer is in flight, this submits the queue and waits for
+     * a buffer to be released.
+     */
+    bool send_to(std::span<const uint8_t> data, const endpoint_type& endpoint)
+    {
+        if (data.size() > m_buffer_size) {
+            return false;
+        }
+        reap_sends();
+        while (m_free_slots.empty()) {
+            m_send_ring.enter(1, std::chrono::seconds{ 1 });
+            reap_sends();
+        }
+        auto sqe = m_send_ring.get_sqe();
+        if (sqe == nullptr) {
+            submit();
+            sqe = m_send_ring.get_sqe();
+            if (sqe == nullptr) {
+                return false;
+            }
+        }
+        const auto slot = m_free_slots.back();
+        m_free_slots.pop_back();
+        auto buffer = m_send_pool.data() + slot * m_buffer_size;
+        std::memcpy(buffer, data.data(), data.size());
+        m_send_dest[slot] = endpoint;
+        sqe->opcode = IORING_OP_SEND_ZC;
+        sqe->fd = m_socket.native_handle();
+        sqe->addr = reinterpret_cast<uint64_t>(buffer);
+        sqe->len = static_cast<uint32_t>(data.size());
+        sqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+        sqe->buf_index = slot;
+        sqe->addr2 = reinterpret_cast<uint64_t>(&m_send_dest[slot].sockaddr());
+        sqe->addr_len = static_cast<uint16_t>(m_send_dest[slot].socklen());
+        sqe->user_data = slot;
+        return true;
+    }
+
+    /**
+     * @brief Submit all queued sends with a single system call
+     * @return Number of sends submitted on success, otherwise -1 for error
+     */
+    int submit()
+    {
+        auto res = m_send_ring.enter(0);
+        reap_sends();
+        return res;
+    }
+
+    /**
+     * @brief Get the number of sends that completed with an error
+     * @return Cumulative count of failed sends
+     */
+    std::size_t send_errors() const noexcept
+    {
+        return m_send_errors;
+    }
+
+private:
+    static constexpr unsigned RING_ENTRIES = 8;
+    static constexpr uint16_t BUFFER_GROUP = 0;
+    static constexpr uint64_t RECV_TAG = ~uint64_t{ 0 };
+    static constexpr uint64_t CANCEL_TAG = RECV_TAG - 1;
+    static constexpr std::size_t CONTROL_SIZE = socket_type::CONTROL_SIZE;
+    static constexpr std::size_t RECV_OVERHEAD = sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_in6) + CONTROL_SIZE;
+
+    socket_type& m_socket;
+    detail::uring m_recv_ring;
+    detail::uring m_send_ring;
+    std::size_t m_buffer_count;
+    std::size_t m_buffer_size;
+    std::vector<uint8_t> m_recv_pool;
+    std::vector<uint8_t> m_send_pool;
+    std::vector<endpoint_type> m_send_dest;
+    std::vector<uint16_t> m_free_slots;
+    io_uring_buf* m_buf_ring{ nullptr };
+    std::size_t m_buf_ring_size{};
+    uint16_t m_buf_tail{};
+    msghdr m_recv_msg{};
+    bool m_recv_armed{ false };
+    std::size_t m_send_errors{};
+
+    void arm_receive()
+    {
+        if (auto sqe = m_recv_ring.get_sqe(); sqe != nullptr) {
+            sqe->opcode = IORING_OP_RECVMSG;
+            sqe->fd = m_socket.native_handle();
+            sqe->addr = reinterpret_cast<uint64_t>(&m_recv_msg);
+            sqe->len = 1;
+            sqe->ioprio = IORING_RECV_MULTISHOT;
+            sqe->flags = IOSQE_BUFFER_SELECT;
+            sqe->buf_group = BUFFER_GROUP;
+            sqe->user_data = RECV_TAG;
+            m_recv_armed = true;
+        }
+    }
+
+    void add_buffer(const uint16_t bid)
+    {
+        auto& buf = m_buf_ring[m_buf_tail & (m_buffer_count - 1)];
+        buf.addr = reinterpret_cast<uint64_t>(m_recv_pool.data() + bid * m_buffer_size);
+        buf.len = static_cast<uint32_t>(m_buffer_size);
+        buf.bid = bid;
+        ++m_buf_tail;
+    }
+
+    void publish_buffers()
+    {
+        // The ring tail overlays the reserved field of the first entry
+        std::atomic_ref<uint16_t>(m_buf_ring[0].resv).store(m_buf_tail, std::memory_order_release);
+    }
+
+    void reap_sends()
+    {
+        m_send_ring.for_each_cqe([this](const io_uring_cqe& cqe)
+        {
+            const auto slot = static_cast<uint16_t>(cqe.user_data);
+            if (cqe.flags & IORING_CQE_F_NOTIF) {
+                m_free_slots.push_back(slot);
+                return;
+            }
+            if (cqe.res < 0) {
+                ++m_send_errors;
+            }
+            // Zero-copy sends post a separate notification once the buffer
+            // may be reused; otherwise the buffer is free now
+            if (!(cqe.flags & IORING_CQE_F_MORE)) {
+                m_free_slots.push_back(slot);
+            }
+        });
+    }
+
+}; // end class uring_datagram
+
+namespace uring {
+
+/**
+ * @typedef io_uring backend for UDP IPv4 sockets
+ */
+using v4 = uring_datagram<AF_INET>;
+/**
+ * @typedef io_uring backend for UDP IPv6 sockets
+ */
+using v6 = uring_datagram<AF_INET6>;
+
+} // end namespace uring
+
+} // end namespace vrtgen::io
+
+#endif // VRTGEN_HAS_IO_URING
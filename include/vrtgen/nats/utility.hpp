@@ -28,17 +28,18 @@
 namespace vrtgen {
 
 template <class CtrlT, class ...AckT>
-auto send_packet(vrtgen::nats::client& client, const std::string& subject, CtrlT& packet, AckT&... acks)
+auto send_packet_for(vrtgen::nats::client& client, const std::string& subject, CtrlT& packet,
+                     const std::chrono::nanoseconds timeout, AckT&... acks)
 {
     // Send packet
     client.publish(subject, packet.data(), client.inbox());
     // Receive acks on unique reply subject
-    const auto recv_ack = [&client](auto& ack)
+    const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(timeout);
+    const auto recv_ack = [&client, wait](auto& ack)
     {
         if (!ack.has_value()) { return; }
-        using namespace std::chrono_literals;
         using ack_t = typename std::remove_reference_t<decltype(ack)>::value_type;
-        if (auto msg = client.next_inbox_msg(2s)) {
+        if (auto msg = client.next_inbox_msg(wait)) {
             if (auto match_err = ack_t::match(msg->data())) {
                 throw std::runtime_error("incorrect acknowledgement type: " + match_err.value());
             }
@@ -50,4 +51,11 @@ auto send_packet(vrtgen::nats::client& client, const std::string& subject, CtrlT
     (recv_ack(acks), ...);
 }
 
+template <class CtrlT, class ...AckT>
+auto send_packet(vrtgen::nats::client& client, const std::string& subject, CtrlT& packet, AckT&... acks)
+{
+    using namespace std::chrono_literals;
+    send_packet_for(client, subject, packet, 2s, acks...);
+}
+
 } // end namespace vrtgen
\ No newline at end of file
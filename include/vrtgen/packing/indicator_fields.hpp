@@ -24,6 +24,11 @@
 
 #pragma once
 
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
 #include <vrtgen/types/packed.hpp>
 
 namespace vrtgen::packing {
@@ -53,6 +58,50 @@ public:
         return m_packed.none();
     }
 
+    /**
+     * @brief Returns the IndicatorField bits as one word
+     * @return Indicator word in host byte order, with bit N of the VRT word at bit N
+     */
+    uint32_t word() const noexcept
+    {
+        return m_packed.value();
+    }
+
+    /**
+     * @brief Sets all of the IndicatorField bits from one word
+     * @param value Indicator word in host byte order, with bit N of the VRT word at bit N
+     */
+    void word(const uint32_t value) noexcept
+    {
+        m_packed.value(value);
+    }
+
+    /**
+     * @brief Returns the number of IndicatorField bits set to true
+     * @return Number of set bits
+     */
+    std::size_t count() const noexcept
+    {
+        return static_cast<std::size_t>(std::popcount(word()));
+    }
+
+    /**
+     * @brief Calls a function with the position of each bit set to true
+     * @param func Callable invoked as func(position) for each set bit
+     *
+     * Bits are visited from position 31 down to 0, the order in which the
+     * fields they indicate are packed.
+     */
+    template <class F>
+    void for_each_set(F&& func) const
+    {
+        for (auto bits = word(); bits != 0;) {
+            const auto position = 31 - std::countl_zero(bits);
+            bits &= ~(uint32_t{ 1 } << position);
+            func(position);
+        }
+    }
+
     /**
      * @brief Returns the number of IndicatorField bytes
      * @return Number of IndicatorField bytes
@@ -85,6 +134,42 @@ protected:
 
 }; // end class IndicatorField
 
+/**
+ * @brief Returns the bits set in both indicator fields
+ */
+template <class T>
+requires std::derived_from<T, IndicatorField>
+T operator&(const T& lhs, const T& rhs) noexcept
+{
+    auto result = lhs;
+    result.word(lhs.word() & rhs.word());
+    return result;
+}
+
+/**
+ * @brief Returns the bits set in either indicator field
+ */
+template <class T>
+requires std::derived_from<T, IndicatorField>
+T operator|(const T& lhs, const T& rhs) noexcept
+{
+    auto result = lhs;
+    result.word(lhs.word() | rhs.word());
+    return result;
+}
+
+/**
+ * @brief Returns the bits that differ between the indicator fields
+ */
+template <class T>
+requires std::derived_from<T, IndicatorField>
+T operator^(const T& lhs, const T& rhs) noexcept
+{
+    auto result = lhs;
+    result.word(lhs.word() ^ rhs.word());
+    return result;
+}
+
 /**
  * @class IndicatorField0
  * @brief Base class for Indicator Field Word 0
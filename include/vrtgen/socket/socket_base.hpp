@@ -21,9 +21,13 @@
 #define VRTGEN_SOCKET_SOCKET_BASE_HPP
 
 #include <sys/socket.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
 #include <unistd.h>
 #include <netinet/ip.h>
 #include <arpa/inet.h>
+#include <chrono>
 #include <cstring>
 #include <stdexcept>
 #include <sys/time.h>
@@ -199,6 +203,125 @@ public:
         setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(tv));
     }
 
+    /**
+     * @brief Set send timeout for socket
+     * @param timeout The desired socket send timeout (in seconds); 0 waits indefinitely
+     */
+    void send_timeout(const size_t timeout)
+    {
+        struct timeval tv;
+        tv.tv_sec = timeout;
+        tv.tv_usec = 0;
+        setsockopt(m_socket, SOL_SOCKET, SO_SNDTIMEO, (const char*)&tv, sizeof(tv));
+    }
+
+    /**
+     * @brief Allow the socket to bind an address and port already in use (SO_REUSEADDR).
+     *        For UDP this lets several receivers on one host bind the same multicast group.
+     * @param enable true to allow address reuse, false to disallow
+     * @return true on success, otherwise false
+     */
+    bool reuse_address(const bool enable)
+    {
+        int value = enable ? 1 : 0;
+        return setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &value, sizeof(value)) == 0;
+    }
+
+    /**
+     * @brief Allow multiple sockets to bind the same address and port (SO_REUSEPORT).
+     *        Must be set on every socket in the group before bind().
+     * @param enable true to allow port sharing, false to disallow
+     * @return true on success, otherwise false
+     */
+    bool reuse_port(const bool enable)
+    {
+        int value = enable ? 1 : 0;
+        return setsockopt(m_socket, SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value)) == 0;
+    }
+
+    /**
+     * @brief Set or clear non-blocking mode on the socket
+     * @param enable true for non-blocking I/O, false for blocking I/O
+     * @return true on success, otherwise false
+     */
+    bool nonblocking(const bool enable)
+    {
+        return set_nonblocking(m_socket, enable);
+    }
+
+    /**
+     * @brief Enable low-latency receive by busy polling
+     * @param budget Time to spin waiting for data before blocking; zero disables busy polling
+     * @param yield true to call sched_yield() between polls, for when the peer may share
+     *              this CPU; false (the default) spins continuously
+     * @return true if SO_BUSY_POLL was applied, otherwise false
+     *
+     * Sets SO_BUSY_POLL so the kernel polls the device queue instead of
+     * waiting for an interrupt, and makes receive calls spin with MSG_DONTWAIT
+     * for up to budget before falling back to a blocking receive. This trades
+     * CPU for latency and is intended for command/acknowledge traffic. Raising
+     * SO_BUSY_POLL above net.core.busy_read requires CAP_NET_ADMIN; the
+     * user-space spin is enabled regardless.
+     */
+    bool busy_poll(const std::chrono::microseconds budget, const bool yield = false)
+    {
+        m_spin_budget = budget;
+        m_spin_yield = yield;
+        int usec = static_cast<int>(budget.count());
+        return setsockopt(m_socket, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec)) == 0;
+    }
+
+    /**
+     * @brief Get the busy poll spin budget
+     * @return Time receive calls spin before blocking; zero if busy polling is disabled
+     */
+    std::chrono::microseconds busy_poll() const noexcept
+    {
+        return m_spin_budget;
+    }
+
+    /**
+     * @brief Set the kernel receive buffer size (SO_RCVBUF)
+     * @param bytes Requested buffer size in bytes
+     * @param force true to exceed net.core.rmem_max with SO_RCVBUFFORCE when
+     *              the process has CAP_NET_ADMIN; falls back to SO_RCVBUF otherwise
+     * @return true on success, otherwise false
+     */
+    bool receive_buffer_size(const int bytes, const bool force = false)
+    {
+        return set_buffer_size(SO_RCVBUF, SO_RCVBUFFORCE, bytes, force);
+    }
+
+    /**
+     * @brief Get the kernel receive buffer size
+     * @return Buffer size in bytes as reported by the kernel, or -1 on failure
+     */
+    int receive_buffer_size() const
+    {
+        return get_buffer_size(SO_RCVBUF);
+    }
+
+    /**
+     * @brief Set the kernel send buffer size (SO_SNDBUF)
+     * @param bytes Requested buffer size in bytes
+     * @param force true to exceed net.core.wmem_max with SO_SNDBUFFORCE when
+     *              the process has CAP_NET_ADMIN; falls back to SO_SNDBUF otherwise
+     * @return true on success, otherwise false
+     */
+    bool send_buffer_size(const int bytes, const bool force = false)
+    {
+        return set_buffer_size(SO_SNDBUF, SO_SNDBUFFORCE, bytes, force);
+    }
+
+    /**
+     * @brief Get the kernel send buffer size
+     * @return Buffer size in bytes as reported by the kernel, or -1 on failure
+     */
+    int send_buffer_size() const
+    {
+        return get_buffer_size(SO_SNDBUF);
+    }
+
 protected:
     static constexpr int INVALID_SOCKET = -1;
     static constexpr int STANDARD_PROTOCOL = 0;
@@ -221,13 +344,129 @@ protected:
         }
         this->timeout(TIMEOUT);
     }
-    
+
+    /**
+     * @brief Set or clear O_NONBLOCK on a file descriptor
+     * @param fd File descriptor to modify
+     * @param enable true for non-blocking I/O, false for blocking I/O
+     * @return true on success, otherwise false
+     */
+    static bool set_nonblocking(const int fd, const bool enable)
+    {
+        auto flags = fcntl(fd, F_GETFL, 0);
+        if (flags < 0) {
+            return false;
+        }
+        flags = enable ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+        return fcntl(fd, F_SETFL, flags) == 0;
+    }
+
+    /**
+     * @brief Perform a receive, spinning for the busy poll budget before blocking
+     * @param receive Callable performing the receive system call with the given flags
+     * @return Result of the receive
+     */
+    template <class F>
+    ssize_t spin_receive(F&& receive)
+    {
+        if (m_spin_budget.count() > 0) {
+            const auto deadline = std::chrono::steady_clock::now() + m_spin_budget;
+            do {
+                auto res = receive(MSG_DONTWAIT);
+                if (res >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    return res;
+                }
+                if (m_spin_yield) {
+                    sched_yield();
+                }
+            } while (std::chrono::steady_clock::now() < deadline);
+        }
+        return receive(0);
+    }
+
+    /**
+     * @brief Perform a receive that gives up at a deadline
+     * @param fd File descriptor to receive on
+     * @param receive Callable performing the receive system call with the given flags
+     * @param timeout Maximum time to wait for data
+     * @return Result of the receive, or -1 with errno set to ETIMEDOUT if no data arrived in time
+     *
+     * Spins for the busy poll budget first, then waits in ppoll() for the
+     * remaining time. Unlike a blocking receive this ignores the socket
+     * receive timeout and needs no helper thread.
+     */
+    template <class F>
+    ssize_t timed_receive(const int fd, F&& receive, const std::chrono::nanoseconds timeout)
+    {
+        using clock = std::chrono::steady_clock;
+        const auto deadline = clock::now() + timeout;
+        const auto spin_deadline = std::min(deadline, clock::now() + m_spin_budget);
+        for (auto spinning = m_spin_budget.count() > 0; ; ) {
+            auto res = receive(MSG_DONTWAIT);
+            if (res >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                return res;
+            }
+            const auto now = clock::now();
+            if (now >= deadline) {
+                errno = ETIMEDOUT;
+                return -1;
+            }
+            if (spinning && now < spin_deadline) {
+                if (m_spin_yield) {
+                    sched_yield();
+                }
+                continue;
+            }
+            spinning = false;
+            const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+            const auto wait = timespec{ static_cast<time_t>(remaining.count() / 1'000'000'000),
+                                        static_cast<long>(remaining.count() % 1'000'000'000) };
+            pollfd pfd{ fd, POLLIN, 0 };
+            if (ppoll(&pfd, 1, &wait, nullptr) < 0 && errno != EINTR) {
+                return -1;
+            }
+        }
+    }
+
+    /**
+     * @brief Set a socket buffer size, optionally trying the privileged option first
+     * @param option SO_RCVBUF or SO_SNDBUF
+     * @param force_option SO_RCVBUFFORCE or SO_SNDBUFFORCE
+     * @param bytes Requested buffer size in bytes
+     * @param force true to try force_option before option
+     * @return true on success, otherwise false
+     */
+    bool set_buffer_size(const int option, const int force_option, const int bytes, const bool force)
+    {
+        if (force && setsockopt(m_socket, SOL_SOCKET, force_option, &bytes, sizeof(bytes)) == 0) {
+            return true;
+        }
+        return setsockopt(m_socket, SOL_SOCKET, option, &bytes, sizeof(bytes)) == 0;
+    }
+
+    /**
+     * @brief Get a socket buffer size
+     * @param option SO_RCVBUF or SO_SNDBUF
+     * @return Buffer size in bytes, or -1 on failure
+     */
+    int get_buffer_size(const int option) const
+    {
+        int bytes{};
+        socklen_t len = sizeof(bytes);
+        if (getsockopt(m_socket, SOL_SOCKET, option, &bytes, &len) != 0) {
+            return -1;
+        }
+        return bytes;
+    }
+
     int m_socket{ INVALID_SOCKET }; /**< Socket file descriptor */
     int m_domain; /**< Communication domain */
     int m_type; /**< Socket type */
     int m_protocol{ STANDARD_PROTOCOL }; /**< Socket protocol */
     endpoint_type m_src; /** Socket's source endpoint */
     endpoint_type m_dst; /** Socket's destination endpoint */
+    std::chrono::microseconds m_spin_budget{}; /**< Busy poll spin budget */
+    bool m_spin_yield{ false }; /**< Yield the CPU between busy polls */
 
 }; // end class socket_base
 
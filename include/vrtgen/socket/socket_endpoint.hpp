@@ -62,7 +62,16 @@ public:
     {
         return sockaddr.sin_addr;
     }
-}; // end class endpoint_traits<AF_INET6>
+    /**
+     * @brief Determine whether an IP address is a multicast group address
+     * @param address The IP address to test
+     * @return true if address is in 224.0.0.0/4, otherwise false
+     */
+    static bool is_multicast(const address_type& address)
+    {
+        return IN_MULTICAST(ntohl(address.s_addr));
+    }
+}; // end class endpoint_traits<AF_INET>
 
 /**
  * @class endpoint_traits<AF_INET6>
@@ -93,6 +102,15 @@ public:
     {
         return sockaddr.sin6_addr;
     }
+    /**
+     * @brief Determine whether an IP address is a multicast group address
+     * @param address The IP address to test
+     * @return true if address is in ff00::/8, otherwise false
+     */
+    static bool is_multicast(const address_type& address)
+    {
+        return IN6_IS_ADDR_MULTICAST(&address);
+    }
 }; // end class endpoint_traits<AF_INET6>
 
 } // end namespace detail
@@ -189,6 +207,15 @@ public:
         }
     }
 
+    /**
+     * @brief Determine whether the endpoint address is a multicast group
+     * @return true if the address is a multicast group address, otherwise false
+     */
+    bool is_multicast() const noexcept
+    {
+        return endpoint::detail::endpoint_traits<domain_type>::is_multicast(get_address(m_sockaddr));
+    }
+
     /**
      * @brief Get the endpoint port number
      * @return Endpoint's port number
@@ -20,7 +20,12 @@
 #ifndef VRTGEN_SOCKET_TCP_HPP
 #define VRTGEN_SOCKET_TCP_HPP
 
+#include <array>
 #include <iostream>
+#include <span>
+#include <vector>
+#include <netinet/tcp.h>
+#include <poll.h>
 
 #include "socket_base.hpp"
 
@@ -83,9 +88,41 @@ public:
         }
         m_connected_socket = res;
         this->m_dst = endpoint;
+        ++m_accepted;
         return true;
     }
 
+    /**
+     * @brief Get the number of connections accepted
+     * @return Count that changes with every accepted connection, so it also
+     *         identifies the current one
+     */
+    uint64_t accepted() const noexcept
+    {
+        return m_accepted;
+    }
+
+    /**
+     * @brief Determine whether a connection has been accepted
+     * @return true if there is an accepted connection, otherwise false
+     */
+    bool connected() const noexcept
+    {
+        return m_is_connected();
+    }
+
+    /**
+     * @brief Close the accepted connection, if any.
+     *        The listening socket stays open so that another connection can be accepted.
+     */
+    void disconnect()
+    {
+        if (m_is_connected()) {
+            ::close(m_connected_socket);
+            m_connected_socket = this->INVALID_SOCKET;
+        }
+    }
+
     /**
      * @brief Write data to the socket
      * @param data Pointer to start of message data
@@ -100,6 +137,116 @@ public:
         return write(this->m_socket, data, len);
     }
 
+    /**
+     * @brief Read data off the socket, waiting at most a given time
+     * @param data Pointer to start of buffer where received message data will be written
+     * @param len Size of data buffer
+     * @param timeout Maximum time to wait for data
+     * @return Number of bytes read, 0 if the peer closed the connection, otherwise -1
+     *         for error; errno is ETIMEDOUT if no data arrived in time
+     */
+    ssize_t read_for(void* data, const size_t len, const std::chrono::nanoseconds timeout)
+    {
+        const auto fd = io_handle();
+        return this->timed_receive(fd, [&](const int flags) { return recv(fd, data, len, flags); }, timeout);
+    }
+
+    /**
+     * @brief Write all of a buffer to the socket, retrying after short writes
+     * @param data Pointer to start of message data
+     * @param len Size of message
+     * @return len on success, otherwise -1 for error
+     *
+     * Waits for buffer space if the socket is non-blocking, each time for at
+     * most the socket send timeout (see send_timeout()); errno is ETIMEDOUT if none
+     * became available. Never raises SIGPIPE; a closed peer is reported as an
+     * error with errno set to EPIPE.
+     */
+    ssize_t write_all(const void* data, const size_t len)
+    {
+        const auto buffer = std::span<const uint8_t>{ static_cast<const uint8_t*>(data), len };
+        return write_all(std::span<const std::span<const uint8_t>>{ &buffer, 1 });
+    }
+
+    /**
+     * @brief Write several buffers to the socket with as few system calls as possible
+     * @param buffers Buffers to write in order, e.g. several packed VRT packets
+     * @return Total number of bytes written on success, otherwise -1 for error
+     *
+     * Up to IOVEC_BATCH buffers are gathered into each sendmsg(), the
+     * equivalent of writev(), and short writes are resumed where they stopped.
+     * Does not allocate. Waits for buffer space as write_all(const void*, size_t) does.
+     */
+    ssize_t write_all(std::span<const std::span<const uint8_t>> buffers)
+    {
+        std::array<iovec, IOVEC_BATCH> iovecs;
+        const auto fd = io_handle();
+        auto total = std::size_t{};
+        auto next = std::size_t{};   // First buffer not yet written in full
+        auto offset = std::size_t{}; // Bytes of buffers[next] already written
+        while (true) {
+            auto count = std::size_t{};
+            for (auto i = next; i < buffers.size() && count < iovecs.size(); ++i) {
+                const auto skip = i == next ? offset : 0;
+                if (buffers[i].size() > skip) {
+                    iovecs[count++] = { const_cast<uint8_t*>(buffers[i].data()) + skip, buffers[i].size() - skip };
+                }
+            }
+            if (count == 0) {
+                break;
+            }
+            msghdr msg{};
+            msg.msg_iov = iovecs.data();
+            msg.msg_iovlen = count;
+            auto res = sendmsg(fd, &msg, MSG_NOSIGNAL);
+            if (res < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if ((errno == EAGAIN || errno == EWOULDBLOCK) && m_wait_writable(fd)) {
+                    continue;
+                }
+                return -1;
+            }
+            // Skip the buffers that were written in full and note where the one cut short stopped
+            auto written = static_cast<std::size_t>(res);
+            total += written;
+            while (next < buffers.size() && written >= buffers[next].size() - offset) {
+                written -= buffers[next].size() - offset;
+                offset = 0;
+                ++next;
+            }
+            offset += written;
+        }
+        return static_cast<ssize_t>(total);
+    }
+
+    /**
+     * @brief Send small writes immediately instead of waiting to coalesce them (TCP_NODELAY)
+     * @param enable true to disable Nagle's algorithm, favouring latency, e.g. for commands
+     * @return true on success, otherwise false
+     *
+     * Applies to the accepted connection if there is one. Connections accepted
+     * later inherit the setting from the listening socket.
+     */
+    bool nodelay(const bool enable)
+    {
+        int value = enable ? 1 : 0;
+        return setsockopt(io_handle(), IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value)) == 0;
+    }
+
+    /**
+     * @brief Hold back partial segments until uncorked (TCP_CORK)
+     * @param enable true to only send full segments, favouring throughput, e.g. for bulk
+     *               data; false to flush whatever is queued
+     * @return true on success, otherwise false
+     */
+    bool cork(const bool enable)
+    {
+        int value = enable ? 1 : 0;
+        return setsockopt(io_handle(), IPPROTO_TCP, TCP_CORK, &value, sizeof(value)) == 0;
+    }
+
     /**
      * @brief Read data off the socket
      * @param data Pointer to start of buffer where received message data will be written
@@ -108,22 +255,148 @@ public:
      */
     ssize_t read_some(void* data, const size_t len)
     {
-        if (m_is_connected()) {
-            return read(m_connected_socket, data, len);
-        }
-        return read(this->m_socket, data, len);
+        const auto fd = io_handle();
+        return this->spin_receive([&](const int flags) { return recv(fd, data, len, flags); });
     }
 
+    /**
+     * @brief Set or clear non-blocking mode on the socket used for I/O.
+     *        This is the accepted connection if there is one.
+     * @param enable true for non-blocking I/O, false for blocking I/O
+     * @return true on success, otherwise false
+     */
+    bool nonblocking(const bool enable)
+    {
+        return base_type::set_nonblocking(io_handle(), enable);
+    }
+
+    /**
+     * @brief Get the file descriptor used by read_some() and write_some()
+     * @return The accepted connection if there is one, otherwise the native socket
+     */
+    int io_handle() const noexcept
+    {
+        return m_is_connected() ? m_connected_socket : this->m_socket;
+    }
+
+    static constexpr std::size_t IOVEC_BATCH = 64; /**< Buffers gathered into each sendmsg() by write_all() */
+
 private:
     int m_connected_socket = this->INVALID_SOCKET;
+    uint64_t m_accepted = 0;
 
     bool m_is_connected() const noexcept
     {
         return m_connected_socket != this->INVALID_SOCKET;
     }
 
+    /**
+     * @brief Wait until fd can be written, for at most the socket timeout
+     * @param fd File descriptor to wait on
+     * @return true if fd may be written or the wait was interrupted, otherwise
+     *         false with errno set, ETIMEDOUT if the timeout expired
+     */
+    bool m_wait_writable(const int fd) const
+    {
+        // A zero SO_SNDTIMEO means no timeout, as for blocking sends
+        timeval tv{};
+        socklen_t len = sizeof(tv);
+        auto timeout_ms = -1;
+        if (getsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, &len) == 0 && (tv.tv_sec > 0 || tv.tv_usec > 0)) {
+            timeout_ms = static_cast<int>(tv.tv_sec * 1000 + tv.tv_usec / 1000);
+        }
+        pollfd pfd{ fd, POLLOUT, 0 };
+        auto res = poll(&pfd, 1, timeout_ms);
+        if (res == 0) {
+            errno = ETIMEDOUT;
+            return false;
+        }
+        return res > 0 || errno == EINTR;
+    }
+
 }; // end class stream_socket
 
+/**
+ * @class stream_writer
+ * @brief Coalesces packets written to a stream socket into large writes
+ *
+ * Packets are copied into a staging buffer and written with a single
+ * write_all() once the buffer reaches its flush threshold, or when flush() is
+ * called. This trades latency for fewer system calls and fuller segments and
+ * suits bulk data/context traffic; send latency-sensitive commands directly
+ * with nodelay() enabled instead.
+ */
+template <int domain>
+class stream_writer
+{
+public:
+    /**
+     * @brief Constructor
+     * @param socket Connected socket to write to; must outlive the writer
+     * @param flush_threshold Number of staged bytes that triggers a write
+     */
+    explicit stream_writer(stream_socket<domain>& socket, const std::size_t flush_threshold = 65536) :
+        m_socket(socket),
+        m_flush_threshold(flush_threshold)
+    {
+        m_staged.reserve(flush_threshold);
+    }
+
+    /**
+     * @brief Destructor.
+     *        Writes any staged packets.
+     */
+    ~stream_writer()
+    {
+        flush();
+    }
+
+    stream_writer(const stream_writer&) = delete;
+    stream_writer& operator=(const stream_writer&) = delete;
+
+    /**
+     * @brief Stage a packet, writing the staged packets if the threshold is reached
+     * @param packet Packed packet to send; copied, so it may be reused on return
+     * @return true on success, otherwise false if a write failed
+     */
+    bool write(std::span<const uint8_t> packet)
+    {
+        m_staged.insert(m_staged.end(), packet.begin(), packet.end());
+        if (m_staged.size() >= m_flush_threshold) {
+            return flush();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Write all staged packets
+     * @return true on success, otherwise false
+     */
+    bool flush()
+    {
+        if (m_staged.empty()) {
+            return true;
+        }
+        auto res = m_socket.write_all(m_staged.data(), m_staged.size());
+        m_staged.clear();
+        return res >= 0;
+    }
+
+    /**
+     * @brief Get the number of bytes staged but not yet written
+     */
+    std::size_t staged() const noexcept
+    {
+        return m_staged.size();
+    }
+
+private:
+    stream_socket<domain>& m_socket;
+    std::size_t m_flush_threshold;
+    std::vector<uint8_t> m_staged;
+
+}; // end class stream_writer
+
 namespace tcp {
 
 /**
@@ -134,6 +407,14 @@ using v4 = socket::stream_socket<AF_INET>;
  * @typedef TCP IPv6 socket
  */
 using v6 = socket::stream_socket<AF_INET6>;
+/**
+ * @typedef TCP IPv4 coalescing writer
+ */
+using writer_v4 = socket::stream_writer<AF_INET>;
+/**
+ * @typedef TCP IPv6 coalescing writer
+ */
+using writer_v6 = socket::stream_writer<AF_INET6>;
 
 } // end namespace tcp
 
@@ -21,9 +21,23 @@
 #define VRTGEN_SOCKET_UDP_HPP
 
 #include <iostream>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <span>
+#include <algorithm>
+#include <netinet/udp.h>
+#include <linux/filter.h>
 
 #include "socket_base.hpp"
 
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103 /**< Linux UDP GSO socket option, missing from older libc headers */
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104 /**< Linux UDP GRO socket option, missing from older libc headers */
+#endif
+
 namespace vrtgen {
 namespace socket {
 
@@ -37,10 +51,16 @@ template <int domain>
 class datagram_socket : public socket_base<domain, SOCK_DGRAM>
 {
     using base_type = socket_base<domain, SOCK_DGRAM>;
+    using sockaddr_type = typename base_type::endpoint_type::sockaddr_type;
 
 public:
     using endpoint_type = typename base_type::endpoint_type;
 
+    using time_point = std::chrono::system_clock::time_point;
+
+    static constexpr std::size_t MAX_BATCH = 64; /**< Maximum number of messages per batch system call */
+    static constexpr std::size_t CONTROL_SIZE = CMSG_SPACE(sizeof(timespec)) + CMSG_SPACE(sizeof(uint32_t)); /**< Control buffer size for timestamp and drop count messages */
+
     /**
      * @brief Constructor
      * @throw std::runtime_error Failed to create socket
@@ -76,9 +96,507 @@ public:
      */
     ssize_t receive_from(void* data, const size_t len, endpoint_type& endpoint)
     {
-        return recvfrom(this->m_socket, data, len, 0, (sockaddr*)&endpoint.sockaddr(), &endpoint.socklen());
+        return this->spin_receive([&](const int flags)
+        {
+            return recvfrom(this->m_socket, data, len, flags, (sockaddr*)&endpoint.sockaddr(), &endpoint.socklen());
+        });
+    }
+
+    /**
+     * @brief Receive a message on the socket, waiting at most a given time
+     * @param data Pointer to start of buffer where received message data will be written
+     * @param len Size of data buffer
+     * @param endpoint Endpoint to be populated with source endpoint information
+     * @param timeout Maximum time to wait for a message
+     * @return Number of bytes received on success, otherwise -1 for error;
+     *         errno is ETIMEDOUT if no message arrived in time
+     */
+    ssize_t receive_for(void* data, const size_t len, endpoint_type& endpoint, const std::chrono::nanoseconds timeout)
+    {
+        return this->timed_receive(this->m_socket, [&](const int flags)
+        {
+            return recvfrom(this->m_socket, data, len, flags, (sockaddr*)&endpoint.sockaddr(), &endpoint.socklen());
+        }, timeout);
+    }
+
+    /**
+     * @brief Receive a message on the socket along with its GRO segment size
+     * @param data Pointer to start of buffer where received message data will be written
+     * @param len Size of data buffer
+     * @param endpoint Endpoint to be populated with source endpoint information
+     * @param segment_size Populated with the size of each datagram coalesced into the
+     *                     message, or the full message length if it was not coalesced
+     * @return Number of bytes received on success, otherwise -1 for error
+     *
+     * When GRO is enabled (see gro()), a single receive may return several
+     * datagrams from the same flow laid out back to back. All but the last are
+     * segment_size bytes long.
+     */
+    ssize_t receive_from(void* data, const size_t len, endpoint_type& endpoint, std::size_t& segment_size)
+    {
+        iovec iov{ data, len };
+        alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int)) + CONTROL_SIZE> control;
+        msghdr msg{};
+        msg.msg_name = &endpoint.sockaddr();
+        msg.msg_namelen = sizeof(sockaddr_type);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control.data();
+        msg.msg_controllen = control.size();
+        auto res = this->spin_receive([&](const int flags) { return recvmsg(this->m_socket, &msg, flags); });
+        if (res < 0) {
+            return res;
+        }
+        endpoint.socklen() = msg.msg_namelen;
+        segment_size = static_cast<std::size_t>(res);
+        process_control(msg);
+        for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                int gso_size;
+                std::memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+                segment_size = static_cast<std::size_t>(gso_size);
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief Receive a message on the socket along with its kernel arrival time
+     * @param data Pointer to start of buffer where received message data will be written
+     * @param len Size of data buffer
+     * @param endpoint Endpoint to be populated with source endpoint information
+     * @param arrival Populated with the time the kernel received the message, or
+     *                the epoch if receive timestamps are not enabled (see timestamps())
+     * @return Number of bytes received on success, otherwise -1 for error
+     */
+    ssize_t receive_from(void* data, const size_t len, endpoint_type& endpoint, time_point& arrival)
+    {
+        iovec iov{ data, len };
+        alignas(cmsghdr) std::array<char, CONTROL_SIZE> control;
+        msghdr msg{};
+        msg.msg_name = &endpoint.sockaddr();
+        msg.msg_namelen = sizeof(sockaddr_type);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control.data();
+        msg.msg_controllen = control.size();
+        auto res = this->spin_receive([&](const int flags) { return recvmsg(this->m_socket, &msg, flags); });
+        if (res < 0) {
+            return res;
+        }
+        endpoint.socklen() = msg.msg_namelen;
+        arrival = process_control(msg);
+        return res;
+    }
+
+    /**
+     * @brief Send a buffer as multiple equally sized datagrams using UDP GSO
+     * @param data Message data, consisting of back-to-back datagram payloads
+     * @param segment_size Size of each datagram; the final datagram may be shorter
+     * @param endpoint Destination endpoint for the messages
+     * @return Number of bytes sent on success, otherwise -1 for error
+     *
+     * The kernel (or NIC) splits data into segment_size datagrams, so a burst
+     * of equally sized VRT packets costs a single system call and a single
+     * trip through the network stack. Requires Linux 4.18 or later. data may
+     * hold at most 64 segments and must be smaller than 64 KiB.
+     */
+    ssize_t send_segmented(std::span<const uint8_t> data, const uint16_t segment_size, const endpoint_type& endpoint)
+    {
+        iovec iov{ const_cast<uint8_t*>(data.data()), data.size() };
+        alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(uint16_t))> control{};
+        msghdr msg{};
+        msg.msg_name = const_cast<sockaddr_type*>(&endpoint.sockaddr());
+        msg.msg_namelen = endpoint.socklen();
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control.data();
+        msg.msg_controllen = control.size();
+        auto cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+        return sendmsg(this->m_socket, &msg, 0);
+    }
+
+    /**
+     * @brief Enable or disable UDP generic receive offload (GRO)
+     * @param enable true to allow the kernel to coalesce received datagrams
+     * @return true on success, otherwise false
+     *
+     * With GRO enabled, back-to-back datagrams from one flow may be delivered
+     * by a single receive call. Use vrtgen::for_each_packet() to split the
+     * coalesced buffer back into individual VRT packets.
+     */
+    bool gro(const bool enable)
+    {
+        int value = enable ? 1 : 0;
+        return setsockopt(this->m_socket, SOL_UDP, UDP_GRO, &value, sizeof(value)) == 0;
+    }
+
+    /**
+     * @brief Enable or disable kernel software receive timestamps (SO_TIMESTAMPNS)
+     * @param enable true to record the arrival time of each received datagram
+     * @return true on success, otherwise false
+     */
+    bool timestamps(const bool enable)
+    {
+        int value = enable ? 1 : 0;
+        return setsockopt(this->m_socket, SOL_SOCKET, SO_TIMESTAMPNS, &value, sizeof(value)) == 0;
+    }
+
+    /**
+     * @brief Bind the socket to a multicast group and join it
+     * @param group Multicast group address and port to receive on
+     * @param interface Index of the interface to join on; 0 lets the kernel choose
+     * @return true on success, otherwise false
+     *
+     * Enables address reuse so several receivers on one host can share the
+     * group, and binds to the group address so only its traffic is received.
+     */
+    bool bind_multicast(const endpoint_type& group, const unsigned interface = 0)
+    {
+        return this->reuse_address(true) && this->bind(group) && join_group(group, interface);
+    }
+
+    /**
+     * @brief Join a multicast group (any-source multicast)
+     * @param group Multicast group to join; the port is ignored
+     * @param interface Index of the interface to join on; 0 lets the kernel choose
+     * @return true on success, otherwise false
+     */
+    bool join_group(const endpoint_type& group, const unsigned interface = 0)
+    {
+        return m_group_request(MCAST_JOIN_GROUP, group, interface);
+    }
+
+    /**
+     * @brief Leave a multicast group joined with join_group()
+     * @param group Multicast group to leave; the port is ignored
+     * @param interface Index of the interface the group was joined on
+     * @return true on success, otherwise false
+     */
+    bool leave_group(const endpoint_type& group, const unsigned interface = 0)
+    {
+        return m_group_request(MCAST_LEAVE_GROUP, group, interface);
+    }
+
+    /**
+     * @brief Join a multicast group, receiving only from one source (source-specific multicast)
+     * @param group Multicast group to join; the port is ignored
+     * @param source Unicast address of the sender; the port is ignored
+     * @param interface Index of the interface to join on; 0 lets the kernel choose
+     * @return true on success, otherwise false
+     */
+    bool join_source_group(const endpoint_type& group, const endpoint_type& source, const unsigned interface = 0)
+    {
+        return m_source_group_request(MCAST_JOIN_SOURCE_GROUP, group, source, interface);
+    }
+
+    /**
+     * @brief Leave a source-specific multicast group joined with join_source_group()
+     * @param group Multicast group to leave; the port is ignored
+     * @param source Unicast address of the sender; the port is ignored
+     * @param interface Index of the interface the group was joined on
+     * @return true on success, otherwise false
+     */
+    bool leave_source_group(const endpoint_type& group, const endpoint_type& source, const unsigned interface = 0)
+    {
+        return m_source_group_request(MCAST_LEAVE_SOURCE_GROUP, group, source, interface);
     }
-    
+
+    /**
+     * @brief Set the time-to-live (IPv4) or hop limit (IPv6) of outgoing multicast datagrams
+     * @param hops Number of router hops; 1 keeps traffic on the local network
+     * @return true on success, otherwise false
+     */
+    bool multicast_ttl(const int hops)
+    {
+        const auto option = domain == AF_INET ? IP_MULTICAST_TTL : IPV6_MULTICAST_HOPS;
+        return setsockopt(this->m_socket, IP_LEVEL, option, &hops, sizeof(hops)) == 0;
+    }
+
+    /**
+     * @brief Enable or disable delivery of outgoing multicast datagrams to receivers on this host
+     * @param enable true to loop datagrams back, false to suppress them
+     * @return true on success, otherwise false
+     */
+    bool multicast_loop(const bool enable)
+    {
+        const auto option = domain == AF_INET ? IP_MULTICAST_LOOP : IPV6_MULTICAST_LOOP;
+        int value = enable ? 1 : 0;
+        return setsockopt(this->m_socket, IP_LEVEL, option, &value, sizeof(value)) == 0;
+    }
+
+    /**
+     * @brief Set the interface outgoing multicast datagrams are sent on
+     * @param interface Interface index (see if_nametoindex()); 0 restores the routing table default
+     * @return true on success, otherwise false
+     */
+    bool multicast_interface(const unsigned interface)
+    {
+        if constexpr (domain == AF_INET) {
+            ip_mreqn request{};
+            request.imr_ifindex = static_cast<int>(interface);
+            return setsockopt(this->m_socket, IP_LEVEL, IP_MULTICAST_IF, &request, sizeof(request)) == 0;
+        } else {
+            int index = static_cast<int>(interface);
+            return setsockopt(this->m_socket, IP_LEVEL, IPV6_MULTICAST_IF, &index, sizeof(index)) == 0;
+        }
+    }
+
+    /**
+     * @brief Enable or disable kernel drop accounting (SO_RXQ_OVFL)
+     * @param enable true to have the kernel report its drop count with each datagram
+     * @return true on success, otherwise false
+     *
+     * The count is read from every receive that collects control messages,
+     * i.e. all receive functions except the plain receive_from(). See drops().
+     */
+    bool drop_counting(const bool enable)
+    {
+        int value = enable ? 1 : 0;
+        if (setsockopt(this->m_socket, SOL_SOCKET, SO_RXQ_OVFL, &value, sizeof(value)) != 0) {
+            return false;
+        }
+        m_drop_counting = enable;
+        return true;
+    }
+
+    /**
+     * @brief Get the number of datagrams the kernel dropped because the receive buffer was full
+     * @return Cumulative drop count as of the most recently received datagram
+     */
+    uint32_t drops() const noexcept
+    {
+        return m_drops.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Grow the receive buffer automatically when the kernel reports drops
+     * @param max_bytes Largest receive buffer size to grow to; 0 disables auto-tuning
+     *
+     * Each time drops() increases the receive buffer is doubled, up to max_bytes.
+     * Requires drop_counting() to be enabled.
+     */
+    void receive_buffer_autotune(const int max_bytes)
+    {
+        m_autotune_max = max_bytes;
+    }
+
+    /**
+     * @brief Process the control messages of a received message
+     * @param msg Message header populated by recvmsg, recvmmsg or io_uring
+     * @return The kernel arrival time, or the epoch if the message carries no timestamp
+     *
+     * Updates drops() and applies receive buffer auto-tuning if the message
+     * carries a drop count.
+     */
+    time_point process_control(const msghdr& msg) noexcept
+    {
+        auto arrival = time_point{};
+        auto& hdr = const_cast<msghdr&>(msg);
+        for (auto cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+            if (cmsg->cmsg_level != SOL_SOCKET) {
+                continue;
+            }
+            if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                timespec ts;
+                std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                arrival = time_point{ std::chrono::duration_cast<time_point::duration>(
+                    std::chrono::seconds{ ts.tv_sec } + std::chrono::nanoseconds{ ts.tv_nsec }) };
+            } else if (cmsg->cmsg_type == SO_RXQ_OVFL) {
+                uint32_t drops;
+                std::memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+                if (m_drops.exchange(drops, std::memory_order_relaxed) != drops && m_autotune_max > 0) {
+                    m_grow_receive_buffer();
+                }
+            }
+        }
+        return arrival;
+    }
+
+    /**
+     * @brief Steer datagrams across an SO_REUSEPORT group by VRT stream ID
+     * @param group_size Number of sockets bound to the port with reuse_port()
+     * @return true on success, otherwise false
+     *
+     * Attaches a classic BPF program to the reuse port group that selects
+     * socket (stream ID % group_size), where the stream ID is the second
+     * 32-bit word of the datagram. Every packet of a stream is delivered to
+     * the same socket, preserving per-stream ordering. Sockets are indexed in
+     * the order they were bound. Packet types without a stream ID (signal and
+     * extension data, types 0 and 2) select no socket, so the kernel falls
+     * back to hashing the sender's address and port, keeping each sender's
+     * packets on one socket and in order.
+     */
+    bool steer_by_stream_id(const uint32_t group_size)
+    {
+        if (group_size == 0) {
+            return false;
+        }
+        // Offsets are relative to the start of the UDP payload. An index at or
+        // above the group size makes the kernel use its 4-tuple hash instead.
+        constexpr uint32_t NO_SOCKET = 0xFFFFFFFF;
+        sock_filter code[] = {
+            BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 0),
+            BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 4),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 4, 0), // Signal data without stream ID
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 2, 3, 0), // Extension data without stream ID
+            BPF_STMT(BPF_LD | BPF_W | BPF_ABS, sizeof(uint32_t)),
+            BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, group_size),
+            BPF_STMT(BPF_RET | BPF_A, 0),
+            BPF_STMT(BPF_RET | BPF_K, NO_SOCKET),
+        };
+        sock_fprog program{ static_cast<unsigned short>(std::size(code)), code };
+        return setsockopt(this->m_socket, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) == 0;
+    }
+
+    /**
+     * @brief Send multiple messages on the socket with a single system call per batch
+     * @param buffers Message data, one span per datagram
+     * @param endpoint Destination endpoint for all messages
+     * @return Number of messages sent on success, otherwise -1 for error
+     *
+     * Messages are submitted with sendmmsg in groups of at most MAX_BATCH. If
+     * an error occurs after some messages have been sent, the number of
+     * messages sent so far is returned.
+     */
+    int send_batch(std::span<const std::span<const uint8_t>> buffers, const endpoint_type& endpoint)
+    {
+        std::array<mmsghdr, MAX_BATCH> headers;
+        std::array<iovec, MAX_BATCH> iovecs;
+        auto sent = std::size_t{};
+        while (sent < buffers.size()) {
+            const auto count = std::min(buffers.size() - sent, MAX_BATCH);
+            for (auto i = std::size_t{}; i < count; ++i) {
+                iovecs[i].iov_base = const_cast<uint8_t*>(buffers[sent + i].data());
+                iovecs[i].iov_len = buffers[sent + i].size();
+                headers[i] = mmsghdr{};
+                headers[i].msg_hdr.msg_name = const_cast<sockaddr_type*>(&endpoint.sockaddr());
+                headers[i].msg_hdr.msg_namelen = endpoint.socklen();
+                headers[i].msg_hdr.msg_iov = &iovecs[i];
+                headers[i].msg_hdr.msg_iovlen = 1;
+            }
+            auto res = sendmmsg(this->m_socket, headers.data(), count, 0);
+            if (res < 0) {
+                return sent > 0 ? static_cast<int>(sent) : -1;
+            }
+            sent += res;
+        }
+        return static_cast<int>(sent);
+    }
+
+    /**
+     * @brief Receive multiple messages on the socket with a single system call
+     * @param buffers Buffers where received message data will be written, one per message
+     * @param lengths Populated with the number of bytes received into each buffer
+     * @param endpoints Populated with the source endpoint of each message
+     * @param arrivals Optionally populated with the kernel arrival time of each
+     *                 message (see timestamps()); must be empty or as large as buffers
+     * @return Number of messages received on success, otherwise -1 for error
+     *
+     * Blocks (subject to the socket timeout) until at least one message is
+     * available, then returns every queued message that fits in the provided
+     * buffers, up to MAX_BATCH. lengths and endpoints must be at least as
+     * large as buffers.
+     */
+    int receive_batch(std::span<const std::span<uint8_t>> buffers,
+                      std::span<std::size_t> lengths,
+                      std::span<endpoint_type> endpoints,
+                      std::span<time_point> arrivals = {})
+    {
+        using control_buffer = std::array<char, CONTROL_SIZE>;
+        std::array<mmsghdr, MAX_BATCH> headers;
+        std::array<iovec, MAX_BATCH> iovecs;
+        alignas(cmsghdr) std::array<control_buffer, MAX_BATCH> controls;
+        const auto count = std::min({ buffers.size(), lengths.size(), endpoints.size(), MAX_BATCH });
+        const auto want_arrivals = arrivals.size() >= count;
+        const auto want_control = want_arrivals || m_drop_counting;
+        for (auto i = std::size_t{}; i < count; ++i) {
+            iovecs[i].iov_base = buffers[i].data();
+            iovecs[i].iov_len = buffers[i].size();
+            headers[i] = mmsghdr{};
+            headers[i].msg_hdr.msg_name = &endpoints[i].sockaddr();
+            headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_type);
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+            if (want_control) {
+                headers[i].msg_hdr.msg_control = controls[i].data();
+                headers[i].msg_hdr.msg_controllen = controls[i].size();
+            }
+        }
+        auto res = this->spin_receive([&](const int flags)
+        {
+            return recvmmsg(this->m_socket, headers.data(), count, MSG_WAITFORONE | flags, nullptr);
+        });
+        for (auto i = 0; i < res; ++i) {
+            lengths[i] = headers[i].msg_len;
+            endpoints[i].socklen() = headers[i].msg_hdr.msg_namelen;
+            if (want_control) {
+                auto arrival = process_control(headers[i].msg_hdr);
+                if (want_arrivals) {
+                    arrivals[i] = arrival;
+                }
+            }
+        }
+        return res;
+    }
+
+private:
+    static constexpr int IP_LEVEL = domain == AF_INET ? IPPROTO_IP : IPPROTO_IPV6;
+
+    /**
+     * @brief Issue a protocol-independent (RFC 3678) group membership request
+     * @param option MCAST_JOIN_GROUP or MCAST_LEAVE_GROUP
+     * @param group Multicast group address
+     * @param interface Interface index
+     * @return true on success, otherwise false
+     */
+    bool m_group_request(const int option, const endpoint_type& group, const unsigned interface)
+    {
+        group_req request{};
+        request.gr_interface = interface;
+        std::memcpy(&request.gr_group, &group.sockaddr(), sizeof(sockaddr_type));
+        return setsockopt(this->m_socket, IP_LEVEL, option, &request, sizeof(request)) == 0;
+    }
+
+    /**
+     * @brief Issue a protocol-independent (RFC 3678) source-specific membership request
+     * @param option MCAST_JOIN_SOURCE_GROUP or MCAST_LEAVE_SOURCE_GROUP
+     * @param group Multicast group address
+     * @param source Source address
+     * @param interface Interface index
+     * @return true on success, otherwise false
+     */
+    bool m_source_group_request(const int option, const endpoint_type& group, const endpoint_type& source,
+                                const unsigned interface)
+    {
+        group_source_req request{};
+        request.gsr_interface = interface;
+        std::memcpy(&request.gsr_group, &group.sockaddr(), sizeof(sockaddr_type));
+        std::memcpy(&request.gsr_source, &source.sockaddr(), sizeof(sockaddr_type));
+        return setsockopt(this->m_socket, IP_LEVEL, option, &request, sizeof(request)) == 0;
+    }
+
+    /**
+     * @brief Double the receive buffer, bounded by the auto-tune maximum
+     */
+    void m_grow_receive_buffer() noexcept
+    {
+        // The kernel reports twice the requested size to account for bookkeeping overhead
+        const auto current = this->receive_buffer_size() / 2;
+        if (current <= 0 || current >= m_autotune_max) {
+            return;
+        }
+        this->receive_buffer_size(std::min(current * 2, m_autotune_max), true);
+    }
+
+    std::atomic<uint32_t> m_drops{}; /**< Kernel drop count from the most recent SO_RXQ_OVFL message */
+    bool m_drop_counting{ false }; /**< Whether SO_RXQ_OVFL is enabled */
+    int m_autotune_max{}; /**< Receive buffer auto-tune limit in bytes; 0 when disabled */
+
 }; // end class datagram_socket
 
 namespace udp {
@@ -92,6 +92,24 @@ public:
         m_value = vrtgen::swap::to_be(static_cast<value_type>(old_value | field_value));
     }
 
+    /**
+     * @brief Returns all of the packed bits as one integer in host byte order
+     * @return Packed value, with bit N of the VRT word at bit N of the integer
+     */
+    inline constexpr value_type value() const noexcept
+    {
+        return vrtgen::swap::from_be(m_value);
+    }
+
+    /**
+     * @brief Sets all of the packed bits from one integer in host byte order
+     * @param value Packed value, with bit N of the VRT word at bit N of the integer
+     */
+    inline constexpr void value(const value_type value) noexcept
+    {
+        m_value = vrtgen::swap::to_be(value);
+    }
+
     /**
      * @brief Checks if any of the packed bits are set to true
      * @return true if any of the bits are set to true, otherwise false
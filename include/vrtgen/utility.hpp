@@ -21,12 +21,21 @@
 
 #include <string>
 #include <stdexcept>
+#include <algorithm>
 #include <array>
-#include <future>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <optional>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <span>
+#include <vector>
 #include <vrtgen/socket.hpp>
+#include <vrtgen/packing/command.hpp>
+#include <vrtgen/packing/header.hpp>
 
 namespace vrtgen {
 
@@ -58,74 +67,781 @@ inline bool in_range(const T value, const std::pair<T,T>& min_max)
     return true;
 }
 
+/**
+ * @brief Invoke a function on each VRT packet in a buffer of back-to-back packets
+ * @param buffer Buffer holding one or more VRT packets, e.g. a GRO-coalesced datagram
+ * @param func Function called with a span over each complete packet
+ * @return Number of bytes consumed; less than buffer.size() if the buffer ends
+ *         with an incomplete packet
+ *
+ * Packet boundaries are found from each header's packet_size field. A packet
+ * size of zero stops the iteration since the remaining bytes cannot be framed.
+ */
+template <class F>
+inline std::size_t for_each_packet(std::span<const uint8_t> buffer, F&& func)
+{
+    auto offset = std::size_t{};
+    packing::Header header;
+    while (buffer.size() - offset >= header.size()) {
+        header.unpack_from(buffer.data() + offset);
+        const auto packet_bytes = static_cast<std::size_t>(header.packet_size()) * sizeof(uint32_t);
+        if (packet_bytes == 0 || packet_bytes > buffer.size() - offset) {
+            break;
+        }
+        func(buffer.subspan(offset, packet_bytes));
+        offset += packet_bytes;
+    }
+    return offset;
+}
+
+/**
+ * @class packet_framer
+ * @brief Reassembles VRT packets from a byte stream such as a TCP connection
+ *
+ * Stream reads may return part of a packet or several packets at once. The
+ * framer reads large chunks into a single buffer and cuts packets at the
+ * boundaries given by each header's packet_size field. Complete packets are
+ * returned as spans into the buffer, and bytes are only moved when a partial
+ * packet would not fit before the end of the buffer.
+ */
+class packet_framer
+{
+public:
+    static constexpr std::size_t MAX_PACKET_SIZE = 0xFFFF * sizeof(uint32_t); /**< Largest VRT packet in bytes */
+
+    /**
+     * @brief Constructor
+     * @param capacity Buffer size in bytes; raised to MAX_PACKET_SIZE if smaller so any packet fits
+     */
+    explicit packet_framer(const std::size_t capacity = 4 * MAX_PACKET_SIZE) :
+        m_buffer(std::max(capacity, MAX_PACKET_SIZE))
+    {
+    }
+
+    /**
+     * @brief Read as many bytes as are available from a stream into the buffer
+     * @param socket Stream to read from, providing read_some(void*, size_t)
+     * @return Number of bytes read, 0 if the peer closed the stream, otherwise -1 for error
+     *
+     * Invalidates spans previously returned by next() and for_each().
+     */
+    template <class SockT>
+    ssize_t read_from(SockT& socket)
+    {
+        return m_read([&socket](auto data, auto len) { return socket.read_some(data, len); });
+    }
+
+    /**
+     * @brief Read as many bytes as are available from a stream, waiting at most a given time
+     * @param socket Stream to read from, providing read_for(void*, size_t, nanoseconds)
+     * @param timeout Maximum time to wait for data
+     * @return Number of bytes read, 0 if the peer closed the stream, otherwise -1 for
+     *         error; errno is ETIMEDOUT if no data arrived in time
+     *
+     * Invalidates spans previously returned by next() and for_each().
+     */
+    template <class SockT>
+    ssize_t read_from(SockT& socket, const std::chrono::nanoseconds timeout)
+    {
+        return m_read([&socket, timeout](auto data, auto len) { return socket.read_for(data, len, timeout); });
+    }
+
+    /**
+     * @brief Get the next complete packet from the buffer
+     * @return Span of the packet, valid until the next read_from(), or
+     *         std::nullopt if the next packet has not fully arrived
+     *
+     * A packet size of zero cannot be framed past, so the buffered bytes are
+     * discarded when one is found.
+     */
+    std::optional<std::span<const uint8_t>> next()
+    {
+        const auto size = m_pending_size();
+        if (size == 0 || size > buffered()) {
+            return std::nullopt;
+        }
+        auto packet = std::span<const uint8_t>{ m_buffer.data() + m_begin, size };
+        m_begin += size;
+        return packet;
+    }
+
+    /**
+     * @brief Invoke a function on each complete packet in the buffer
+     * @param func Function called as func(std::span<const uint8_t>)
+     * @return Number of packets passed to func
+     */
+    template <class F>
+    std::size_t for_each(F&& func)
+    {
+        auto count = std::size_t{};
+        while (auto packet = next()) {
+            func(*packet);
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Get the number of buffered bytes not yet returned as packets
+     */
+    std::size_t buffered() const noexcept
+    {
+        return m_end - m_begin;
+    }
+
+    /**
+     * @brief Discard all buffered bytes, e.g. when a new connection is accepted
+     */
+    void clear() noexcept
+    {
+        m_begin = 0;
+        m_end = 0;
+    }
+
+private:
+    /**
+     * @brief Read into the free space at the end of the buffer
+     * @param read Callable reading at most len bytes into data
+     * @return Result of read
+     */
+    template <class F>
+    ssize_t m_read(F&& read)
+    {
+        m_make_room();
+        auto res = read(m_buffer.data() + m_end, m_buffer.size() - m_end);
+        if (res > 0) {
+            m_end += static_cast<std::size_t>(res);
+        }
+        return res;
+    }
+
+    /**
+     * @brief Get the size of the packet at the front of the buffer
+     * @return Packet size in bytes, or 0 if its header has not arrived or is invalid
+     */
+    std::size_t m_pending_size() noexcept
+    {
+        packing::Header header;
+        if (buffered() < header.size()) {
+            return 0;
+        }
+        header.unpack_from(m_buffer.data() + m_begin);
+        const auto size = static_cast<std::size_t>(header.packet_size()) * sizeof(uint32_t);
+        if (size == 0) {
+            clear();
+        }
+        return size;
+    }
+
+    /**
+     * @brief Move a trailing partial packet to the front if it cannot complete in place
+     */
+    void m_make_room() noexcept
+    {
+        if (m_begin == m_end) {
+            clear();
+            return;
+        }
+        const auto needed = std::max(m_pending_size(), sizeof(uint32_t));
+        if (m_begin + needed > m_buffer.size() || m_end == m_buffer.size()) {
+            std::memmove(m_buffer.data(), m_buffer.data() + m_begin, buffered());
+            m_end -= m_begin;
+            m_begin = 0;
+        }
+    }
+
+    std::vector<uint8_t> m_buffer;
+    std::size_t m_begin{ 0 }; /**< Start of the first packet not yet returned */
+    std::size_t m_end{ 0 }; /**< End of the buffered bytes */
+
+}; // end class packet_framer
+
+/**
+ * @brief Get the stream identifier of a packed VRT packet
+ * @param packet Packed VRT packet, starting with the header
+ * @return The stream identifier, or std::nullopt if the packet type has none
+ *         or the packet is too short to hold one
+ */
+inline std::optional<uint32_t> packet_stream_id(std::span<const uint8_t> packet)
+{
+    if (packet.size() < 2 * sizeof(uint32_t)) {
+        return std::nullopt;
+    }
+    packing::Header header;
+    header.unpack_from(packet.data());
+    switch (header.packet_type()) {
+        case packing::PacketType::SIGNAL_DATA:
+        case packing::PacketType::EXTENSION_DATA:
+            return std::nullopt;
+        default:
+            break;
+    }
+    return static_cast<uint32_t>(packet[4]) << 24 | static_cast<uint32_t>(packet[5]) << 16 |
+           static_cast<uint32_t>(packet[6]) << 8 | static_cast<uint32_t>(packet[7]);
+}
+
+/**
+ * @brief Convert a VRT timestamp to a system clock time point
+ * @param tsi Integer-seconds timestamp type
+ * @param integer Integer-seconds timestamp value
+ * @param tsf Fractional-seconds timestamp type
+ * @param fractional Fractional-seconds timestamp value
+ * @param gps_utc_offset Leap seconds GPS time is ahead of UTC, applied to GPS timestamps
+ * @return The time point, or std::nullopt unless the integer timestamp is UTC
+ *         or GPS and the fractional timestamp is real-time or absent
+ */
+inline std::optional<std::chrono::system_clock::time_point> to_time_point(const packing::TSI tsi,
+                                                                          const uint32_t integer,
+                                                                          const packing::TSF tsf,
+                                                                          const uint64_t fractional,
+                                                                          const std::chrono::seconds gps_utc_offset = std::chrono::seconds{ 18 })
+{
+    using namespace std::chrono;
+    constexpr auto GPS_EPOCH = seconds{ 315964800 }; // 1980-01-06T00:00:00Z
+    auto since_epoch = nanoseconds{ seconds{ integer } };
+    switch (tsi) {
+        case packing::TSI::UTC:
+            break;
+        case packing::TSI::GPS:
+            since_epoch += GPS_EPOCH - gps_utc_offset;
+            break;
+        default:
+            return std::nullopt;
+    }
+    switch (tsf) {
+        case packing::TSF::NONE:
+            break;
+        case packing::TSF::REAL_TIME:
+            since_epoch += nanoseconds{ fractional / 1000 }; // picoseconds
+            break;
+        default:
+            return std::nullopt;
+    }
+    return system_clock::time_point{ duration_cast<system_clock::duration>(since_epoch) };
+}
+
+/**
+ * @brief Get the timestamp of a packed VRT packet as a system clock time point
+ * @param packet Packed VRT packet, starting with the header
+ * @param gps_utc_offset Leap seconds GPS time is ahead of UTC, applied to GPS timestamps
+ * @return The time point, or std::nullopt if the packet has no convertible timestamp
+ *
+ * Together with a kernel arrival time (see datagram_socket::timestamps()) this
+ * gives the end-to-end latency of a packet.
+ */
+inline std::optional<std::chrono::system_clock::time_point> packet_time(std::span<const uint8_t> packet,
+                                                                        const std::chrono::seconds gps_utc_offset = std::chrono::seconds{ 18 })
+{
+    packing::Header header;
+    if (packet.size() < header.size()) {
+        return std::nullopt;
+    }
+    header.unpack_from(packet.data());
+    if (header.tsi() == packing::TSI::NONE) {
+        return std::nullopt;
+    }
+    auto offset = header.size();
+    if (packet_stream_id(packet)) {
+        offset += sizeof(uint32_t);
+    }
+    if (header.class_id_enable()) {
+        offset += 2 * sizeof(uint32_t);
+    }
+    const auto tsf_size = header.tsf() == packing::TSF::NONE ? 0 : sizeof(uint64_t);
+    if (packet.size() < offset + sizeof(uint32_t) + tsf_size) {
+        return std::nullopt;
+    }
+    const auto read_word = [&packet](const std::size_t pos)
+    {
+        return static_cast<uint32_t>(packet[pos]) << 24 | static_cast<uint32_t>(packet[pos + 1]) << 16 |
+               static_cast<uint32_t>(packet[pos + 2]) << 8 | static_cast<uint32_t>(packet[pos + 3]);
+    };
+    const auto integer = read_word(offset);
+    auto fractional = uint64_t{};
+    if (tsf_size != 0) {
+        fractional = static_cast<uint64_t>(read_word(offset + 4)) << 32 | read_word(offset + 8);
+    }
+    return to_time_point(header.tsi(), integer, header.tsf(), fractional, gps_utc_offset);
+}
+
+constexpr auto ACK_TIMEOUT = std::chrono::seconds{ 2 }; /**< Default time send_packet() waits for each acknowledgement */
+
+/**
+ * @struct command_key
+ * @brief Identifies a command packet by its sender and message
+ */
+struct command_key
+{
+    std::array<uint8_t, 16> controller_id{}; /**< Controller ID, word or UUID, zero if absent */
+    uint32_t stream_id{}; /**< Stream ID */
+    uint32_t message_id{}; /**< Message ID */
+    uint64_t sender{}; /**< Transport identity of the sender, e.g. its endpoint or connection; set by the receiver */
+
+    bool operator==(const command_key&) const = default;
+};
+
+/**
+ * @brief Read the identifying fields of a command packet without unpacking it
+ * @param packet Packed VRT packet
+ * @return The controller ID, stream ID and message ID, or std::nullopt if the
+ *         packet is not a command packet or is too short
+ */
+inline std::optional<command_key> packet_command_key(std::span<const uint8_t> packet)
+{
+    packing::Header header;
+    if (packet.size() < header.size()) {
+        return std::nullopt;
+    }
+    header.unpack_from(packet.data());
+    if (header.packet_type() != packing::PacketType::COMMAND &&
+        header.packet_type() != packing::PacketType::EXTENSION_COMMAND) {
+        return std::nullopt;
+    }
+    // Header, stream ID, optional class ID and timestamps, then the CAM and message ID
+    auto offset = header.size() + sizeof(uint32_t);
+    if (header.class_id_enable()) {
+        offset += 2 * sizeof(uint32_t);
+    }
+    if (header.tsi() != packing::TSI::NONE) {
+        offset += sizeof(uint32_t);
+    }
+    if (header.tsf() != packing::TSF::NONE) {
+        offset += sizeof(uint64_t);
+    }
+    if (packet.size() < offset + 2 * sizeof(uint32_t)) {
+        return std::nullopt;
+    }
+    const auto read_word = [&packet](const std::size_t pos)
+    {
+        return static_cast<uint32_t>(packet[pos]) << 24 | static_cast<uint32_t>(packet[pos + 1]) << 16 |
+               static_cast<uint32_t>(packet[pos + 2]) << 8 | static_cast<uint32_t>(packet[pos + 3]);
+    };
+    packing::ControlAcknowledgeMode cam;
+    cam.unpack_from(packet.data() + offset);
+    auto key = command_key{};
+    key.stream_id = read_word(header.size());
+    key.message_id = read_word(offset + sizeof(uint32_t));
+    offset += 2 * sizeof(uint32_t);
+    const auto id_size = [](const packing::IdentifierFormat format)
+    {
+        return format == packing::IdentifierFormat::UUID ? std::size_t{ 16 } : sizeof(uint32_t);
+    };
+    if (cam.controllee_enable()) {
+        offset += id_size(cam.controllee_format());
+    }
+    if (cam.controller_enable()) {
+        const auto size = id_size(cam.controller_format());
+        if (packet.size() < offset + size) {
+            return std::nullopt;
+        }
+        std::copy_n(packet.begin() + offset, size, key.controller_id.begin());
+    }
+    return key;
+}
+
+/**
+ * @brief Read the message ID of a command packet without unpacking it
+ * @param packet Packed VRT packet
+ * @return The message ID following the CAM, or std::nullopt if the packet is
+ *         not a command packet or is too short
+ */
+inline std::optional<uint32_t> packet_message_id(std::span<const uint8_t> packet)
+{
+    if (auto key = packet_command_key(packet)) {
+        return key->message_id;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @class duplicate_cache
+ * @brief Bounded cache of the acknowledgements sent for recent commands
+ *
+ * A controller retransmits a command with the same message ID when it does
+ * not receive the acknowledgements. A controllee records the packed
+ * acknowledgements of each command it handles and, when the same command key
+ * arrives again, resends them instead of handling the command twice. The
+ * packet bytes must match too, so a controller that restarts its message IDs
+ * is not answered from the cache for a different command. Entries only match
+ * for the retransmission window after they were stored, so a message ID that
+ * wraps around or is reused much later is handled again. Entries are evicted
+ * oldest first and their storage is reused. Not thread-safe.
+ */
+class duplicate_cache
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr clock::duration DEFAULT_WINDOW = 4 * ACK_TIMEOUT; /**< Default retransmission window */
+
+    /**
+     * @brief Constructor
+     * @param capacity Number of commands remembered; 0 disables the cache
+     * @param window How long after a command is handled a retransmission is recognized
+     */
+    explicit duplicate_cache(const std::size_t capacity = 256, const clock::duration window = DEFAULT_WINDOW) :
+        m_window(window)
+    {
+        this->capacity(capacity);
+    }
+
+    /**
+     * @brief Set the number of commands remembered, discarding every entry
+     * @param capacity Number of commands remembered; 0 disables the cache
+     */
+    void capacity(const std::size_t capacity)
+    {
+        m_entries.clear();
+        m_slots.assign(capacity, slot{});
+        m_next = 0;
+    }
+
+    /**
+     * @brief Get the number of commands remembered
+     */
+    std::size_t capacity() const noexcept
+    {
+        return m_slots.size();
+    }
+
+    /**
+     * @brief Set how long after a command is handled a retransmission is recognized
+     * @param window Retransmission window, e.g. a few acknowledgement timeouts
+     */
+    void window(const clock::duration window) noexcept
+    {
+        m_window = window;
+    }
+
+    /**
+     * @brief Get how long after a command is handled a retransmission is recognized
+     */
+    clock::duration window() const noexcept
+    {
+        return m_window;
+    }
+
+    /**
+     * @brief Look up the acknowledgements sent for a command
+     * @param key Key of the received command, see packet_command_key()
+     * @param command Packed command packet
+     * @param now Current time
+     * @return Packed acknowledgements, back to back, or nullptr if the command is not a duplicate
+     */
+    const std::vector<uint8_t>* find(const command_key& key, std::span<const uint8_t> command,
+                                     const clock::time_point now = clock::now())
+    {
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            return nullptr;
+        }
+        auto& entry = m_slots[it->second];
+        if (now - entry.stored >= m_window) {
+            // Too old to be a retransmission; the slot is reused when its turn comes
+            m_entries.erase(it);
+            entry.used = false;
+            return nullptr;
+        }
+        if (!std::equal(command.begin(), command.end(), entry.command.begin(), entry.command.end())) {
+            return nullptr;
+        }
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return &entry.acks;
+    }
+
+    /**
+     * @brief Remember the acknowledgements sent for a command
+     * @param key Key of the handled command
+     * @param command Packed command packet
+     * @param acks Packed acknowledgements, back to back; may be empty
+     * @param now Current time
+     */
+    void insert(const command_key& key, std::span<const uint8_t> command, std::span<const uint8_t> acks,
+                const clock::time_point now = clock::now())
+    {
+        if (m_slots.empty()) {
+            return;
+        }
+        auto& entry = m_slots[m_next];
+        if (entry.used) {
+            // A newer command with the same key may own the entry by now
+            if (auto it = m_entries.find(entry.key); it != m_entries.end() && it->second == m_next) {
+                m_entries.erase(it);
+            }
+        }
+        entry.key = key;
+        entry.command.assign(command.begin(), command.end());
+        entry.acks.assign(acks.begin(), acks.end());
+        entry.stored = now;
+        entry.used = true;
+        m_entries[key] = m_next;
+        m_next = (m_next + 1) % m_slots.size();
+    }
+
+    /**
+     * @brief Get the number of duplicates found; may be called from any thread
+     */
+    uint64_t hits() const noexcept
+    {
+        return m_hits.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct key_hash
+    {
+        std::size_t operator()(const command_key& key) const noexcept
+        {
+            // FNV-1a over the identifying bytes
+            auto hash = std::size_t{ 14695981039346656037ULL };
+            const auto mix = [&hash](const uint8_t byte)
+            {
+                hash = (hash ^ byte) * std::size_t{ 1099511628211ULL };
+            };
+            std::for_each(key.controller_id.begin(), key.controller_id.end(), mix);
+            for (auto shift = 0; shift < 32; shift += 8) {
+                mix(static_cast<uint8_t>(key.stream_id >> shift));
+                mix(static_cast<uint8_t>(key.message_id >> shift));
+            }
+            for (auto shift = 0; shift < 64; shift += 8) {
+                mix(static_cast<uint8_t>(key.sender >> shift));
+            }
+            return hash;
+        }
+    };
+
+    struct slot
+    {
+        command_key key;
+        std::vector<uint8_t> command;
+        std::vector<uint8_t> acks;
+        clock::time_point stored;
+        bool used{ false };
+    };
+
+    clock::duration m_window;
+    std::vector<slot> m_slots;
+    std::unordered_map<command_key, std::size_t, key_hash> m_entries;
+    std::size_t m_next{ 0 };
+    std::atomic<uint64_t> m_hits{ 0 };
+};
+
+/**
+ * @class expiring_value
+ * @brief Value that is only returned for a limited time after it was stored
+ * @tparam T Type of the value
+ *
+ * Used to reuse the result of a slow read, such as a hardware query, for a
+ * short time. A zero time-to-live disables storing. Not thread-safe.
+ */
+template <class T>
+class expiring_value
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Set how long stored values are returned, discarding the current value
+     * @param ttl Time-to-live; zero or negative disables storing
+     */
+    void ttl(const clock::duration ttl) noexcept
+    {
+        m_ttl = ttl;
+        m_value.reset();
+    }
+
+    /**
+     * @brief Get how long stored values are returned
+     */
+    clock::duration ttl() const noexcept
+    {
+        return m_ttl;
+    }
+
+    /**
+     * @brief Get whether values are stored at all
+     */
+    bool enabled() const noexcept
+    {
+        return m_ttl > clock::duration::zero();
+    }
+
+    /**
+     * @brief Get the stored value if it has not expired
+     * @param now Current time
+     * @return Pointer to the value, or nullptr if there is none or it has expired
+     */
+    const T* get(const clock::time_point now) const noexcept
+    {
+        return m_value.has_value() && now < m_expiry ? &m_value.value() : nullptr;
+    }
+
+    /**
+     * @brief Store a value, ignored when disabled
+     * @param value Value to store
+     * @param now Current time, from which the time-to-live is counted
+     */
+    void set(const T& value, const clock::time_point now)
+    {
+        if (enabled()) {
+            m_value = value;
+            m_expiry = now + m_ttl;
+        }
+    }
+
+    /**
+     * @brief Discard the stored value
+     */
+    void reset() noexcept
+    {
+        m_value.reset();
+    }
+
+private:
+    std::optional<T> m_value;
+    clock::time_point m_expiry;
+    clock::duration m_ttl{ clock::duration::zero() };
+};
+
+/**
+ * @brief Store an acknowledgement in the next expected element of an acknowledgement tuple
+ * @param acks Acknowledgements; engaged optionals are the ones expected, in arrival order
+ * @param received Number of acknowledgements already stored; incremented on success
+ * @param message Packed acknowledgement packet
+ * @return true once every expected acknowledgement has been stored
+ * @throw std::runtime_error The message is not the type of the next expected acknowledgement
+ */
+template <class ...AckT>
+bool store_next_ack(std::tuple<std::optional<AckT>...>& acks, std::size_t& received, std::span<const uint8_t> message)
+{
+    auto expected = std::size_t{};
+    std::apply([&expected, received, message](auto&... ack)
+    {
+        const auto store = [&expected, received, message](auto& slot)
+        {
+            if (!slot.has_value() || expected++ != received) {
+                return;
+            }
+            using ack_t = typename std::remove_reference_t<decltype(slot)>::value_type;
+            if (auto match_err = ack_t::match(message)) {
+                throw std::runtime_error("incorrect acknowledgement type: " + match_err.value());
+            }
+            slot = ack_t{ message };
+        };
+        (store(ack), ...);
+    }, acks);
+    return ++received >= expected;
+}
+
+/**
+ * @brief Send a control packet over UDP and wait for its acknowledgements
+ * @param socket Command socket; the packet is sent to socket.dst()
+ * @param packet Control packet to send
+ * @param timeout Maximum time to wait for each acknowledgement
+ * @param acks Acknowledgements to receive, in order; empty optionals are skipped
+ * @throw std::runtime_error An acknowledgement timed out or was of the wrong type
+ */
 template <class SockT, class CtrlT, class ...AckT>
 requires (std::same_as<SockT, socket::udp::v4>)
-void send_packet(SockT& socket, CtrlT& packet, AckT&... acks)
+void send_packet_for(SockT& socket, CtrlT& packet, const std::chrono::nanoseconds timeout, AckT&... acks)
 {
     auto packed_data = packet.data();
     socket.send_to(packed_data.data(), packed_data.size(), socket.dst());
-    const auto recv_ack = [&socket](auto& ack)
+    if (((!acks.has_value()) && ...)) {
+        return;
+    }
+    std::array<uint8_t, 65536> message;
+    const auto recv_ack = [&socket, &message, timeout](auto& ack)
     {
         if (!ack.has_value()) { return; }
         using ack_t = typename std::remove_reference_t<decltype(ack)>::value_type;
-        std::array<uint8_t, 65536> message{ 0 };
-        std::future<ssize_t> recv_from_fut = std::async(std::launch::async, [&socket, &message]
-        {
-            return socket.receive_from(message.data(), message.size(), socket.dst());
-        });
-        auto status = recv_from_fut.wait_for(std::chrono::seconds(2));
-        if (status == std::future_status::timeout) {
+        auto reply_length = socket.receive_for(message.data(), message.size(), socket.dst(), timeout);
+        if (reply_length < 0) {
             throw std::runtime_error("timed out waiting for acknowledgement");
         }
-        auto reply_length = recv_from_fut.get();
-        if (auto match_err = ack_t::match(message)) {
+        const auto reply = std::span<const uint8_t>{ message.data(), static_cast<std::size_t>(reply_length) };
+        if (auto match_err = ack_t::match(reply)) {
             throw std::runtime_error("incorrect acknowledgement type: " + match_err.value());
         }
-        ack = std::move(ack_t{ { message.data(), static_cast<std::size_t>(reply_length) } });
+        ack = std::move(ack_t{ reply });
     };
     (recv_ack(acks), ...);
 }
 
+/**
+ * @brief Send a control packet over TCP and wait for its acknowledgements
+ * @param socket Connected command socket
+ * @param framer Framer reassembling acknowledgements read from socket; keep one per
+ *               socket and pass it to every call so its buffer is allocated once
+ * @param packet Control packet to send
+ * @param timeout Maximum time to wait for each acknowledgement
+ * @param acks Acknowledgements to receive, in order; empty optionals are skipped
+ * @throw std::runtime_error The send failed, the connection closed, or an
+ *        acknowledgement timed out or was of the wrong type
+ */
 template <class SockT, class CtrlT, class ...AckT>
 requires (std::same_as<SockT, socket::tcp::v4>)
-auto send_packet(SockT& socket, CtrlT& packet, AckT&... acks)
+void send_packet_for(SockT& socket, packet_framer& framer, CtrlT& packet, const std::chrono::nanoseconds timeout, AckT&... acks)
 {
     auto packed_data = packet.data();
-    socket.write_some(packed_data.data(), packed_data.size());
-    auto message = std::array<uint8_t, 65536>{ 0 };
-    auto reply_length = 0;
-    auto read_idx = std::size_t{};
-    const auto recv_ack = [&message, &socket, &reply_length, &read_idx](auto& ack)
+    if (socket.write_all(packed_data.data(), packed_data.size()) < 0) {
+        throw std::runtime_error("failed to send control packet");
+    }
+    if (((!acks.has_value()) && ...)) {
+        return;
+    }
+    // Acknowledgements may arrive split across reads or several to a read
+    const auto recv_ack = [&framer, &socket, timeout](auto& ack)
     {
         if (!ack.has_value()) { return; }
         using ack_t = typename std::remove_reference_t<decltype(ack)>::value_type;
-        if (reply_length > 0) {
-            auto span = std::span<const uint8_t>{ message.data()+read_idx, static_cast<std::size_t>(reply_length) };
-            if (auto match_err = ack_t::match(span)) {
-                throw std::runtime_error("incorrect acknowledgement type: " + match_err.value());
+        auto message = framer.next();
+        while (!message) {
+            auto reply_length = framer.read_from(socket, timeout);
+            if (reply_length == 0) {
+                throw std::runtime_error("connection closed while waiting for acknowledgement packet");
             }
-            ack = std::move(ack_t{ span });
-            reply_length -= ack->size();
-            read_idx += ack->size();
-            return;
+            if (reply_length < 0) {
+                throw std::runtime_error("timed out waiting for acknowledgement packet");
+            }
+            message = framer.next();
         }
-        auto read_fut = std::async(std::launch::async, [&socket, &message]
-        {
-            return socket.read_some(message.data(), message.size());
-        });
-        using namespace std::chrono_literals;
-        if (auto status = read_fut.wait_for(2s); status == std::future_status::timeout) {
-            throw std::runtime_error("timed out waiting for acknowledgement packet");
-        }
-        reply_length = read_fut.get();
-        if (auto match_err = ack_t::match(message)) {
+        if (auto match_err = ack_t::match(*message)) {
             throw std::runtime_error("incorrect acknowledgement type: " + match_err.value());
         }
-        ack = std::move(ack_t{ { message.data(), static_cast<std::size_t>(reply_length) } });
-        reply_length -= ack->size();
-        read_idx = ack->size();
+        ack = std::move(ack_t{ *message });
     };
     (recv_ack(acks), ...);
 }
 
+/**
+ * @brief Send a control packet over TCP and wait for its acknowledgements
+ * @param socket Connected command socket
+ * @param packet Control packet to send
+ * @param timeout Maximum time to wait for each acknowledgement
+ * @param acks Acknowledgements to receive, in order; empty optionals are skipped
+ * @throw std::runtime_error The send failed, the connection closed, or an
+ *        acknowledgement timed out or was of the wrong type
+ *
+ * Reuses one framer per thread, discarding any bytes a previous call left in it.
+ */
+template <class SockT, class CtrlT, class ...AckT>
+requires (std::same_as<SockT, socket::tcp::v4>)
+void send_packet_for(SockT& socket, CtrlT& packet, const std::chrono::nanoseconds timeout, AckT&... acks)
+{
+    thread_local auto framer = packet_framer{ packet_framer::MAX_PACKET_SIZE };
+    framer.clear();
+    send_packet_for(socket, framer, packet, timeout, acks...);
+}
+
+/**
+ * @brief Send a control packet and wait up to ACK_TIMEOUT for each acknowledgement
+ * @see send_packet_for()
+ */
+template <class SockT, class CtrlT, class ...AckT>
+requires (std::same_as<SockT, socket::udp::v4> || std::same_as<SockT, socket::tcp::v4>)
+void send_packet(SockT& socket, CtrlT& packet, AckT&... acks)
+{
+    send_packet_for(socket, packet, ACK_TIMEOUT, acks...);
+}
+
 } // end namespace vrtgen
@@ -385,6 +385,22 @@ class CppGenerator(Generator):
         choices=['tcp', 'udp', 'nats']
     )
 
+    configure_handler = GeneratorOption(
+        '--configure-handler',
+        doc='controllee handler for configure commands: execute (packet) or apply (change-set) [execute]',
+        dtype=str,
+        defval='execute',
+        choices=['execute', 'apply']
+    )
+
+    controllee_dispatch = GeneratorOption(
+        '--controllee-dispatch',
+        doc='controllee handler dispatch: virtual (overrides) or static (CRTP base template) [virtual]',
+        dtype=str,
+        defval='virtual',
+        choices=['virtual', 'static']
+    )
+
     def get_loader(self):
         return self.loader
 
@@ -403,7 +419,9 @@ class CppGenerator(Generator):
             'namespace_': self.namespace_,
             'project_name': self.output_dir,
             'project_version': '0.1.0',
-            'cmd_socket': self.cmd_socket
+            'cmd_socket': self.cmd_socket,
+            'configure_handler': self.configure_handler,
+            'controllee_dispatch': self.controllee_dispatch
         }
 
         self.include_dir = self.output_dir
@@ -474,6 +492,8 @@ class CppGenerator(Generator):
             context['information_class'] = self.information_class[1]
             context['controller_name'] = 'Controller' # self.information_class[0] + 'Controller'
             context['cmd_socket'] = self.cmd_socket
+            context['configure_handler'] = self.configure_handler
+            context['controllee_dispatch'] = self.controllee_dispatch
             template = self.env.get_template('controller.hpp.jinja2')
             self.controller_file = '{}.{}'.format(context['controller_name'], self.header_ext)
             with open(os.path.join(self.include_dir, self.controller_file), 'w') as fp:
@@ -539,6 +539,22 @@ TEST_CASE("CIF0", "[cif0]")
         // Verify unpacked value
         CHECK(unpack_cif0.cif1_enable() == true);
     }
+
+    SECTION("Word")
+    {
+        // Verify zero on construction
+        CHECK(cif0.word() == 0);
+        // Setters
+        cif0.bandwidth(true);
+        cif0.cif1_enable(true);
+        // Bits are at their VRT bit positions in host order
+        CHECK(cif0.word() == 0x20000002);
+        // Unpack
+        cif0.pack_into(packed_bytes.data());
+        unpack_cif0.unpack_from(packed_bytes.data());
+        // Verify unpacked word
+        CHECK(unpack_cif0.word() == 0x20000002);
+    }
 }
 
 TEST_CASE("GPS ASCII") {
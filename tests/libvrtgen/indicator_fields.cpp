@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Geon Technologies, LLC
+ *
+ * This file is part of vrtgen.
+ *
+ * vrtgen is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * vrtgen is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <vector>
+
+#include "catch.hpp"
+#include "bytes.hpp"
+
+#include "vrtgen/packing/cif0.hpp"
+#include "vrtgen/packing/cif1.hpp"
+#include "vrtgen/packing/command.hpp"
+
+using namespace vrtgen::packing;
+
+TEST_CASE("Indicator field bit operations", "[indicator_fields]")
+{
+    SECTION("Warning/Error Indicator Field 0")
+    {
+        WIF0 wif0;
+        CHECK(wif0.count() == 0);
+        wif0.bandwidth(true);
+        wif0.gain(true);
+        wif0.wif1_enable(true);
+        CHECK(wif0.word() == 0x20800002);
+        CHECK(wif0.count() == 3);
+
+        // Visited in packing order, most significant bit first
+        std::vector<int> positions;
+        wif0.for_each_set([&](int position) { positions.push_back(position); });
+        CHECK(positions == std::vector<int>{ 29, 23, 1 });
+
+        EIF0 eif0;
+        eif0.word(0x20000000);
+        CHECK(eif0.bandwidth() == true);
+        CHECK(eif0.gain() == false);
+        bytes packed_bytes{ 0, 0, 0, 0 };
+        eif0.pack_into(packed_bytes.data());
+        CHECK(packed_bytes == bytes{ 0x20, 0, 0, 0 });
+    }
+
+    SECTION("Context Indicator Fields 0 and 1")
+    {
+        CIF0 cif0;
+        cif0.bandwidth(true);
+        cif0.sample_rate(true);
+        cif0.cif1_enable(true);
+        CHECK(cif0.word() == 0x20200002);
+        CHECK(cif0.count() == 3);
+        std::vector<int> positions;
+        cif0.for_each_set([&](int position) { positions.push_back(position); });
+        CHECK(positions == std::vector<int>{ 29, 21, 1 });
+
+        CIF1 cif1;
+        cif1.word(0x80004002);
+        CHECK(cif1.phase_offset() == true);
+        CHECK(cif1.aux_gain() == true);
+        CHECK(cif1.buffer_size() == true);
+        CHECK(cif1.count() == 3);
+        bytes packed_bytes{ 0, 0, 0, 0 };
+        cif1.pack_into(packed_bytes.data());
+        CHECK(packed_bytes == bytes{ 0x80, 0, 0x40, 0x02 });
+        CHECK((cif1 & CIF1{}).none());
+    }
+
+    SECTION("Operators")
+    {
+        WIF0 lhs;
+        WIF0 rhs;
+        lhs.word(0x28000000);
+        rhs.word(0x20800000);
+        const WIF0 both = lhs & rhs;
+        CHECK(both.word() == 0x20000000);
+        CHECK(both.bandwidth() == true);
+        CHECK((lhs | rhs).word() == 0x28800000);
+        CHECK((lhs ^ rhs).word() == 0x08800000);
+        CHECK((lhs ^ lhs).none());
+    }
+
+    SECTION("Warning and Error Response Fields")
+    {
+        WarningErrorFields fields;
+        fields.field_not_executed(true);
+        fields.parameter_out_of_range(true);
+        CHECK(fields.count() == 2);
+        std::vector<int> positions;
+        fields.for_each_set([&](int position) { positions.push_back(position); });
+        CHECK(positions.size() == 2);
+        CHECK(positions.front() == 31);
+
+        WarningErrorFields other;
+        other.word(fields.word());
+        CHECK(other.field_not_executed() == true);
+        CHECK(other.parameter_out_of_range() == true);
+        CHECK((fields ^ other).count() == 0);
+    }
+}
@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2026 Geon Technologies, LLC
+ *
+ * This file is part of vrtgen.
+ *
+ * vrtgen is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * vrtgen is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "bytes.hpp"
+
+#include "vrtgen/io.hpp"
+#include "vrtgen/socket.hpp"
+
+using namespace vrtgen::socket;
+
+TEST_CASE("Reactor services many sockets", "[io][reactor]")
+{
+    using namespace std::chrono_literals;
+    constexpr auto SOCKET_COUNT = 4;
+    constexpr auto MESSAGE_COUNT = 8;
+
+    std::vector<udp::v4> receivers(SOCKET_COUNT);
+    std::vector<endpoint::udp::v4> endpoints(SOCKET_COUNT);
+    std::array<std::atomic_int, SOCKET_COUNT> received{};
+    vrtgen::io::reactor reactor(2);
+    CHECK(reactor.thread_count() == 2);
+
+    for (auto i = 0; i < SOCKET_COUNT; ++i) {
+        REQUIRE(receivers[i].bind({ "127.0.0.1", 0 }));
+        getsockname(receivers[i].native_handle(), (sockaddr*)&endpoints[i].sockaddr(), &endpoints[i].socklen());
+        REQUIRE(receivers[i].nonblocking(true));
+        REQUIRE(reactor.add(receivers[i].native_handle(), [&, i]
+        {
+            // Drain until the socket would block
+            uint8_t buffer[64];
+            endpoint::udp::v4 source;
+            while (receivers[i].receive_from(buffer, sizeof(buffer), source) > 0) {
+                ++received[i];
+            }
+        }));
+    }
+    CHECK_FALSE(reactor.add(receivers[0].native_handle(), [] {}));
+
+    udp::v4 sender;
+    const bytes message{ 1, 2, 3, 4 };
+    for (auto n = 0; n < MESSAGE_COUNT; ++n) {
+        for (const auto& endpoint : endpoints) {
+            REQUIRE(sender.send_to(message.data(), message.size(), endpoint) == static_cast<ssize_t>(message.size()));
+        }
+    }
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    auto done = [&]
+    {
+        for (const auto& count : received) {
+            if (count < MESSAGE_COUNT) {
+                return false;
+            }
+        }
+        return true;
+    };
+    while (!done() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    for (const auto& count : received) {
+        CHECK(count == MESSAGE_COUNT);
+    }
+
+    // A removed socket is no longer serviced
+    REQUIRE(reactor.remove(receivers[0].native_handle()));
+    CHECK_FALSE(reactor.remove(receivers[0].native_handle()));
+    REQUIRE(sender.send_to(message.data(), message.size(), endpoints[0]) == static_cast<ssize_t>(message.size()));
+    std::this_thread::sleep_for(20ms);
+    CHECK(received[0] == MESSAGE_COUNT);
+
+    // Stopping does not wait on socket receive timeouts
+    const auto start = std::chrono::steady_clock::now();
+    reactor.stop();
+    CHECK(std::chrono::steady_clock::now() - start < 1s);
+}
+
+TEST_CASE("Reactor handler exceptions", "[io][reactor]")
+{
+    using namespace std::chrono_literals;
+    udp::v4 receiver;
+    REQUIRE(receiver.bind({ "127.0.0.1", 0 }));
+    endpoint::udp::v4 local;
+    getsockname(receiver.native_handle(), (sockaddr*)&local.sockaddr(), &local.socklen());
+    REQUIRE(receiver.nonblocking(true));
+
+    vrtgen::io::reactor reactor(1);
+    std::atomic_int received{ 0 };
+    REQUIRE(reactor.add(receiver.native_handle(), [&]
+    {
+        uint8_t buffer[64];
+        endpoint::udp::v4 source;
+        while (receiver.receive_from(buffer, sizeof(buffer), source) > 0) {
+            if (++received == 1) {
+                throw std::runtime_error("first packet rejected");
+            }
+        }
+    }));
+
+    // The throwing handler is reported and then serviced again
+    udp::v4 sender;
+    const bytes message{ 1, 2, 3, 4 };
+    const auto wait_for = [&](const int count)
+    {
+        REQUIRE(sender.send_to(message.data(), message.size(), local) == static_cast<ssize_t>(message.size()));
+        const auto deadline = std::chrono::steady_clock::now() + 2s;
+        while (received < count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+        CHECK(received == count);
+    };
+    wait_for(1);
+    wait_for(2);
+    CHECK(reactor.handler_errors() == 1);
+
+    // Nor is the registration left running
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE(reactor.remove(receiver.native_handle()));
+    CHECK(std::chrono::steady_clock::now() - start < 1s);
+}
+
+TEST_CASE("Bounded queue", "[io][queue]")
+{
+    using vrtgen::io::overflow_policy;
+    vrtgen::io::bounded_queue<std::vector<int>> queue(3);
+    CHECK(queue.capacity() == 4);
+
+    auto push = [&queue](const int value, const overflow_policy policy)
+    {
+        return queue.push([value](auto& slot) { slot.assign(1, value); }, policy);
+    };
+    auto pop = [&queue]
+    {
+        auto value = -1;
+        queue.try_pop([&value](auto& slot) { value = slot.front(); });
+        return value;
+    };
+
+    SECTION("FIFO order and drop newest") {
+        for (auto i = 0; i < 4; ++i) {
+            CHECK(push(i, overflow_policy::drop_newest));
+        }
+        CHECK_FALSE(push(4, overflow_policy::drop_newest));
+        for (auto i = 0; i < 4; ++i) {
+            CHECK(pop() == i);
+        }
+        CHECK(pop() == -1);
+        auto stats = queue.stats();
+        CHECK(stats.pushed == 4);
+        CHECK(stats.popped == 4);
+        CHECK(stats.dropped == 1);
+    }
+    SECTION("Drop oldest") {
+        for (auto i = 0; i < 6; ++i) {
+            CHECK(push(i, overflow_policy::drop_oldest));
+        }
+        for (auto i = 2; i < 6; ++i) {
+            CHECK(pop() == i);
+        }
+        auto stats = queue.stats();
+        CHECK(stats.pushed == 6);
+        CHECK(stats.popped == 4);
+        CHECK(stats.dropped == 2);
+    }
+    SECTION("Block and close") {
+        constexpr auto COUNT = 1000;
+        auto consumed = std::vector<int>{};
+        std::thread consumer([&]
+        {
+            while (queue.pop([&consumed](auto& slot) { consumed.push_back(slot.front()); })) {
+            }
+        });
+        auto pushed = 0;
+        for (auto i = 0; i < COUNT; ++i) {
+            pushed += push(i, overflow_policy::block) ? 1 : 0;
+        }
+        CHECK(pushed == COUNT);
+        queue.close();
+        consumer.join();
+        auto expected = std::vector<int>(COUNT);
+        std::iota(expected.begin(), expected.end(), 0);
+        CHECK(consumed == expected);
+        CHECK(queue.stats().dropped == 0);
+    }
+}
+
+TEST_CASE("Timer wheel", "[io][timer_wheel]")
+{
+    using namespace std::chrono_literals;
+    using clock = vrtgen::io::timer_wheel<int>::clock;
+    const auto start = clock::time_point{} + 1h;
+    vrtgen::io::timer_wheel<int> wheel(10ms, 8, start);
+    auto expired = std::vector<int>{};
+    auto collect = [&expired](const int key) { expired.push_back(key); };
+
+    SECTION("Expires timers in deadline order at tick granularity") {
+        wheel.schedule(1, start + 5ms);
+        wheel.schedule(2, start + 25ms);
+        wheel.schedule(3, start + 45ms);
+        CHECK(wheel.size() == 3);
+        CHECK(wheel.advance(start + 9ms, collect) == 0);
+        CHECK(wheel.advance(start + 10ms, collect) == 1);
+        CHECK(expired == std::vector<int>{ 1 });
+        CHECK(wheel.advance(start + 40ms, collect) == 1);
+        CHECK(wheel.advance(start + 50ms, collect) == 1);
+        CHECK(expired == std::vector<int>{ 1, 2, 3 });
+        CHECK(wheel.empty());
+    }
+    SECTION("Deadlines beyond one revolution") {
+        wheel.schedule(1, start + 100ms);
+        CHECK(wheel.advance(start + 80ms, collect) == 0);
+        CHECK(wheel.advance(start + 99ms, collect) == 0);
+        CHECK(wheel.advance(start + 110ms, collect) == 1);
+        CHECK(expired == std::vector<int>{ 1 });
+    }
+    SECTION("Past deadlines and long gaps") {
+        wheel.advance(start + 30ms, collect);
+        wheel.schedule(1, start);
+        wheel.schedule(2, start + 1s + 15ms);
+        CHECK(wheel.advance(start + 40ms, collect) == 1);
+        CHECK(wheel.advance(start + 1s, collect) == 0);
+        CHECK(wheel.advance(start + 1s + 20ms, collect) == 1);
+        CHECK(expired == std::vector<int>{ 1, 2 });
+        CHECK(wheel.empty());
+    }
+}
+
+TEST_CASE("RTT estimator", "[io][rtt]")
+{
+    using namespace std::chrono_literals;
+    vrtgen::io::rtt_estimator rtt(1s, 5ms, 10s);
+    CHECK(rtt.rto() == 1s);
+    CHECK(rtt.samples() == 0);
+
+    // First sample: SRTT = R, RTTVAR = R/2, RTO = SRTT + 4 * RTTVAR
+    rtt.sample(2ms);
+    CHECK(rtt.srtt() == 2ms);
+    CHECK(rtt.rttvar() == 1ms);
+    CHECK(rtt.rto() == 6ms);
+
+    // Later samples are smoothed with alpha = 1/8 and beta = 1/4
+    rtt.sample(10ms);
+    CHECK(rtt.rttvar() == 2750us);
+    CHECK(rtt.srtt() == 3ms);
+    CHECK(rtt.rto() == 14ms);
+
+    // Steady round trips converge and are clamped to the minimum
+    for (auto i = 0; i < 100; ++i) {
+        rtt.sample(100us);
+    }
+    CHECK(rtt.srtt() < 200us);
+    CHECK(rtt.rto() == 5ms);
+
+    // Exponential backoff up to the maximum
+    CHECK(rtt.rto(1) == 10ms);
+    CHECK(rtt.rto(3) == 40ms);
+    CHECK(rtt.rto(20) == 10s);
+}
+
+#if VRTGEN_HAS_IO_URING
+TEST_CASE("io_uring datagram send and receive", "[io][uring]")
+{
+    udp::v4 receiver;
+    udp::v4 sender;
+    REQUIRE(receiver.bind({ "127.0.0.1", 0 }));
+    REQUIRE(sender.bind({ "127.0.0.1", 0 }));
+    endpoint::udp::v4 local;
+    getsockname(receiver.native_handle(), (sockaddr*)&local.sockaddr(), &local.socklen());
+
+    std::optional<vrtgen::io::uring::v4> rx_ring;
+    std::optional<vrtgen::io::uring::v4> tx_ring;
+    try {
+        rx_ring.emplace(receiver, 16, 2048);
+        tx_ring.emplace(sender, 4, 2048, 4);
+    } catch (const std::runtime_error& e) {
+        WARN("io_uring unavailable: " << e.what());
+        return;
+    }
+
+    // More messages than send slots so the send path must recycle buffers
+    std::vector<bytes> messages;
+    for (auto i = 0; i < 10; ++i) {
+        messages.push_back(bytes(4 * (i + 1), static_cast<uint8_t>(i)));
+    }
+    for (const auto& message : messages) {
+        REQUIRE(tx_ring->send_to(message, local));
+    }
+    CHECK(tx_ring->submit() >= 0);
+    CHECK_FALSE(tx_ring->send_to(bytes(4096), local));
+
+    std::vector<bytes> received;
+    for (auto attempt = 0; attempt < 10 && received.size() < messages.size(); ++attempt) {
+        auto count = rx_ring->receive([&](auto data, const auto& source)
+        {
+            received.emplace_back(data.begin(), data.end());
+            CHECK(source.port() != 0);
+        }, std::chrono::milliseconds{ 100 });
+        REQUIRE(count >= 0);
+    }
+    CHECK(received == messages);
+    CHECK(tx_ring->send_errors() == 0);
+
+    // Timeout with nothing pending
+    CHECK(rx_ring->receive([](auto, const auto&) {}, std::chrono::milliseconds{ 10 }) == 0);
+}
+#endif // VRTGEN_HAS_IO_URING
+
+TEST_CASE("AF_PACKET ring capture", "[io][packet_ring]")
+{
+    using namespace std::chrono_literals;
+    udp::v4 receiver;
+    REQUIRE(receiver.bind({ "127.0.0.1", 0 }));
+    endpoint::udp::v4 local;
+    getsockname(receiver.native_handle(), (sockaddr*)&local.sockaddr(), &local.socklen());
+
+    auto ring = std::optional<vrtgen::io::packet_ring>{};
+    try {
+        ring.emplace("lo", std::vector<uint16_t>{ local.port() }, 1 << 16, 4);
+    } catch (const std::runtime_error& e) {
+        WARN(e.what());
+        return;
+    }
+
+    udp::v4 sender;
+    REQUIRE(sender.bind({ "127.0.0.1", 0 }));
+    endpoint::udp::v4 source;
+    getsockname(sender.native_handle(), (sockaddr*)&source.sockaddr(), &source.socklen());
+    constexpr std::size_t COUNT = 16;
+    for (auto i = std::size_t{}; i < COUNT; ++i) {
+        const bytes message(i + 1, static_cast<uint8_t>(i));
+        REQUIRE(sender.send_to(message.data(), message.size(), local) == static_cast<ssize_t>(message.size()));
+    }
+    // Traffic to other ports is filtered out
+    auto other = local;
+    other.port(local.port() + 1);
+    const bytes ignored(4, 0xFF);
+    sender.send_to(ignored.data(), ignored.size(), other);
+
+    std::vector<bytes> captured;
+    auto sources_match = true;
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (captured.size() < COUNT && std::chrono::steady_clock::now() < deadline) {
+        REQUIRE(ring->receive([&](auto payload, const auto& from, auto)
+        {
+            captured.emplace_back(payload.begin(), payload.end());
+            sources_match = sources_match && from.to_string() == source.to_string();
+        }, 100ms) >= 0);
+    }
+    REQUIRE(captured.size() == COUNT);
+    CHECK(sources_match);
+    for (auto i = std::size_t{}; i < COUNT; ++i) {
+        CHECK(captured[i] == bytes(i + 1, static_cast<uint8_t>(i)));
+    }
+    CHECK(ring->receive([](auto, const auto&) {}, 50ms) == 0);
+
+    // Every filter jump must fit in 8 bits
+    std::vector<uint16_t> ports(vrtgen::io::packet_ring::MAX_PORTS + 1, local.port());
+    CHECK_THROWS_AS(vrtgen::io::packet_ring("lo", ports, 1 << 16, 4), std::runtime_error);
+    ports.pop_back();
+    CHECK_NOTHROW(vrtgen::io::packet_ring("lo", ports, 1 << 16, 4));
+}
@@ -0,0 +1,779 @@
+/*
+ * Copyright (C) 2026 Geon Technologies, LLC
+ *
+ * This file is part of vrtgen.
+ *
+ * vrtgen is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * vrtgen is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "bytes.hpp"
+
+#include "vrtgen/socket.hpp"
+#include "vrtgen/utility.hpp"
+
+using namespace vrtgen::socket;
+
+namespace {
+
+/**
+ * Build a minimal VRT packet of the given number of 32-bit words
+ */
+bytes make_packet(const uint16_t words, const uint8_t fill)
+{
+    bytes packet(words * sizeof(uint32_t), fill);
+    packet[0] = 0x10;
+    packet[1] = 0x00;
+    packet[2] = static_cast<uint8_t>(words >> 8);
+    packet[3] = static_cast<uint8_t>(words & 0xFF);
+    return packet;
+}
+
+endpoint::udp::v4 local_endpoint(const udp::v4& socket)
+{
+    endpoint::udp::v4 local;
+    getsockname(socket.native_handle(), (sockaddr*)&local.sockaddr(), &local.socklen());
+    return local;
+}
+
+} // end namespace
+
+TEST_CASE("UDP batch send and receive", "[socket][udp]")
+{
+    udp::v4 receiver;
+    udp::v4 sender;
+    REQUIRE(receiver.bind({ "127.0.0.1", 0 }));
+    // Port 0 binds an ephemeral port, look it up so the sender can target it
+    auto local = local_endpoint(receiver);
+
+    std::vector<bytes> messages{ { 1, 2, 3, 4 }, { 5, 6, 7, 8, 9, 10, 11, 12 }, { 13 } };
+    std::vector<std::span<const uint8_t>> send_spans(messages.begin(), messages.end());
+    REQUIRE(sender.send_batch(send_spans, local) == static_cast<int>(messages.size()));
+
+    std::array<std::array<uint8_t, 64>, udp::v4::MAX_BATCH> storage;
+    std::vector<std::span<uint8_t>> buffers(storage.begin(), storage.end());
+    std::vector<std::size_t> lengths(buffers.size());
+    std::vector<endpoint::udp::v4> sources(buffers.size());
+
+    auto received = std::size_t{};
+    while (received < messages.size()) {
+        auto count = receiver.receive_batch(std::span{ buffers }.subspan(received),
+                                            std::span{ lengths }.subspan(received),
+                                            std::span{ sources }.subspan(received));
+        REQUIRE(count > 0);
+        received += count;
+    }
+    for (auto i = std::size_t{}; i < messages.size(); ++i) {
+        CHECK(bytes(storage[i].begin(), storage[i].begin() + lengths[i]) == messages[i]);
+        CHECK(sources[i].to_string().starts_with("127.0.0.1:"));
+    }
+}
+
+TEST_CASE("Split back-to-back VRT packets", "[socket][utility]")
+{
+    auto first = make_packet(3, 0xAA);
+    auto second = make_packet(5, 0xBB);
+    bytes buffer(first);
+    buffer.insert(buffer.end(), second.begin(), second.end());
+
+    std::vector<bytes> packets;
+    auto collect = [&packets](std::span<const uint8_t> packet)
+    {
+        packets.emplace_back(packet.begin(), packet.end());
+    };
+
+    SECTION("Complete packets")
+    {
+        CHECK(vrtgen::for_each_packet(buffer, collect) == buffer.size());
+        REQUIRE(packets.size() == 2);
+        CHECK(packets[0] == first);
+        CHECK(packets[1] == second);
+    }
+
+    SECTION("Trailing partial packet")
+    {
+        buffer.resize(buffer.size() - 1);
+        CHECK(vrtgen::for_each_packet(buffer, collect) == first.size());
+        REQUIRE(packets.size() == 1);
+        CHECK(packets[0] == first);
+    }
+
+    SECTION("Zero packet size")
+    {
+        auto empty = bytes{ 0x10, 0x00, 0x00, 0x00 };
+        CHECK(vrtgen::for_each_packet(empty, collect) == 0);
+        CHECK(packets.empty());
+    }
+}
+
+TEST_CASE("Reassemble VRT packets from a byte stream", "[socket][utility]")
+{
+    // Stream that returns its bytes in chunks of a fixed size
+    struct chunked_stream
+    {
+        bytes data;
+        std::size_t chunk;
+        std::size_t offset{ 0 };
+
+        ssize_t read_some(void* buffer, const std::size_t len)
+        {
+            const auto count = std::min({ chunk, len, data.size() - offset });
+            std::memcpy(buffer, data.data() + offset, count);
+            offset += count;
+            return static_cast<ssize_t>(count);
+        }
+    };
+
+    constexpr std::size_t COUNT = 200;
+    std::vector<bytes> packets;
+    chunked_stream stream{ {}, GENERATE(3, 4001, 65536) };
+    for (auto i = std::size_t{}; i < COUNT; ++i) {
+        // Sizes vary so packets straddle the end of the buffer at different offsets
+        packets.push_back(make_packet(static_cast<uint16_t>(500 + i * 7), static_cast<uint8_t>(i)));
+        stream.data.insert(stream.data.end(), packets.back().begin(), packets.back().end());
+    }
+
+    vrtgen::packet_framer framer(0);
+    std::vector<bytes> framed;
+    while (framer.read_from(stream) > 0) {
+        framer.for_each([&framed](auto packet)
+        {
+            framed.emplace_back(packet.begin(), packet.end());
+        });
+    }
+    CHECK(framer.buffered() == 0);
+    CHECK(framed == packets);
+}
+
+TEST_CASE("UDP GSO send and GRO receive", "[socket][udp]")
+{
+    udp::v4 receiver;
+    udp::v4 sender;
+    REQUIRE(receiver.bind({ "127.0.0.1", 0 }));
+    REQUIRE(receiver.gro(true));
+    auto local = local_endpoint(receiver);
+
+    constexpr uint16_t WORDS = 16;
+    constexpr std::size_t COUNT = 4;
+    bytes burst;
+    for (auto i = std::size_t{}; i < COUNT; ++i) {
+        auto packet = make_packet(WORDS, static_cast<uint8_t>(i));
+        burst.insert(burst.end(), packet.begin(), packet.end());
+    }
+    auto sent = sender.send_segmented(burst, WORDS * sizeof(uint32_t), local);
+    if (sent < 0 && errno == EIO) {
+        WARN("UDP GSO not supported by this kernel");
+        return;
+    }
+    REQUIRE(sent == static_cast<ssize_t>(burst.size()));
+
+    std::array<uint8_t, 65536> buffer;
+    auto packets = std::size_t{};
+    while (packets < COUNT) {
+        endpoint::udp::v4 source;
+        auto segment_size = std::size_t{};
+        auto len = receiver.receive_from(buffer.data(), buffer.size(), source, segment_size);
+        REQUIRE(len > 0);
+        CHECK(segment_size == WORDS * sizeof(uint32_t));
+        vrtgen::for_each_packet({ buffer.data(), static_cast<std::size_t>(len) }, [&packets](auto packet)
+        {
+            CHECK(packet.size() == WORDS * sizeof(uint32_t));
+            CHECK(packet.back() == packets);
+            ++packets;
+        });
+    }
+    CHECK(packets == COUNT);
+}
+
+TEST_CASE("SO_REUSEPORT steering by stream ID", "[socket][udp]")
+{
+    constexpr uint32_t GROUP_SIZE = 2;
+    std::array<udp::v4, GROUP_SIZE> receivers;
+    REQUIRE(receivers[0].reuse_port(true));
+    REQUIRE(receivers[0].bind({ "127.0.0.1", 0 }));
+    auto local = local_endpoint(receivers[0]);
+    for (auto i = std::size_t{ 1 }; i < GROUP_SIZE; ++i) {
+        REQUIRE(receivers[i].reuse_port(true));
+        REQUIRE(receivers[i].bind(local));
+    }
+    REQUIRE(receivers[0].steer_by_stream_id(GROUP_SIZE));
+    CHECK_FALSE(receivers[0].steer_by_stream_id(0));
+
+    udp::v4 sender;
+    constexpr uint32_t STREAMS = 6;
+    for (auto stream_id = uint32_t{}; stream_id < STREAMS; ++stream_id) {
+        auto packet = make_packet(2, 0);
+        packet[7] = static_cast<uint8_t>(stream_id);
+        REQUIRE(sender.send_to(packet.data(), packet.size(), local) == static_cast<ssize_t>(packet.size()));
+    }
+
+    auto received = uint32_t{};
+    for (auto i = std::size_t{}; i < GROUP_SIZE; ++i) {
+        REQUIRE(receivers[i].nonblocking(true));
+        std::array<uint8_t, 64> buffer;
+        endpoint::udp::v4 source;
+        while (receivers[i].receive_from(buffer.data(), buffer.size(), source) > 0) {
+            CHECK(buffer[7] % GROUP_SIZE == i);
+            ++received;
+        }
+    }
+    CHECK(received == STREAMS);
+
+    // Packets without a stream ID stay together, whatever their second word holds
+    for (auto i = uint32_t{}; i < STREAMS; ++i) {
+        auto packet = make_packet(2, 0);
+        packet[0] = 0x00;
+        packet[7] = static_cast<uint8_t>(i);
+        REQUIRE(sender.send_to(packet.data(), packet.size(), local) == static_cast<ssize_t>(packet.size()));
+    }
+    std::array<uint32_t, GROUP_SIZE> per_shard{};
+    for (auto i = std::size_t{}; i < GROUP_SIZE; ++i) {
+        std::array<uint8_t, 64> buffer;
+        endpoint::udp::v4 source;
+        while (receivers[i].receive_from(buffer.data(), buffer.size(), source) > 0) {
+            CHECK(buffer[7] == per_shard[i]);
+            ++per_shard[i];
+        }
+    }
+    CHECK(std::count(per_shard.begin(), per_shard.end(), STREAMS) == 1);
+}
+
+TEST_CASE("UDP kernel receive timestamps", "[socket][udp]")
+{
+    using namespace std::chrono_literals;
+    udp::v4 receiver;
+    udp::v4 sender;
+    REQUIRE(receiver.bind({ "127.0.0.1", 0 }));
+    REQUIRE(receiver.timestamps(true));
+    auto local = local_endpoint(receiver);
+
+    const bytes message{ 1, 2, 3, 4 };
+    const auto before = std::chrono::system_clock::now();
+    for (auto i = 0; i < 2; ++i) {
+        REQUIRE(sender.send_to(message.data(), message.size(), local) == static_cast<ssize_t>(message.size()));
+    }
+
+    std::array<uint8_t, 64> buffer;
+    endpoint::udp::v4 source;
+    udp::v4::time_point arrival;
+    REQUIRE(receiver.receive_from(buffer.data(), buffer.size(), source, arrival) == static_cast<ssize_t>(message.size()));
+    CHECK(arrival >= before - 1s);
+    CHECK(arrival <= std::chrono::system_clock::now());
+
+    std::array<std::span<uint8_t>, 1> buffers{ buffer };
+    std::array<std::size_t, 1> lengths;
+    std::array<endpoint::udp::v4, 1> sources;
+    std::array<udp::v4::time_point, 1> arrivals;
+    REQUIRE(receiver.receive_batch(buffers, lengths, sources, arrivals) == 1);
+    CHECK(arrivals[0] >= arrival);
+    CHECK(arrivals[0] <= std::chrono::system_clock::now());
+}
+
+TEST_CASE("VRT timestamp conversion", "[utility]")
+{
+    using namespace std::chrono;
+    using vrtgen::packing::TSI;
+    using vrtgen::packing::TSF;
+
+    // 2021-01-01T00:00:00Z plus 1.5 s expressed in picoseconds
+    const auto expected = system_clock::time_point{ seconds{ 1609459200 } + milliseconds{ 1500 } };
+    CHECK(vrtgen::to_time_point(TSI::UTC, 1609459201, TSF::REAL_TIME, 500'000'000'000) == expected);
+    // GPS seconds run from 1980-01-06 and are 18 leap seconds ahead of UTC
+    CHECK(vrtgen::to_time_point(TSI::GPS, 1609459201 - 315964800 + 18, TSF::REAL_TIME, 500'000'000'000) == expected);
+    CHECK_FALSE(vrtgen::to_time_point(TSI::OTHER, 0, TSF::NONE, 0));
+    CHECK_FALSE(vrtgen::to_time_point(TSI::UTC, 0, TSF::SAMPLE_COUNT, 0));
+
+    // Signal data with stream ID, UTC and real-time timestamps
+    bytes packet{ 0x10, 0x60, 0x00, 0x05,
+                  0x12, 0x34, 0x56, 0x78,
+                  0x5F, 0xEE, 0x66, 0x01,
+                  0x00, 0x00, 0x00, 0x74,
+                  0x6A, 0x52, 0x88, 0x00 };
+    CHECK(vrtgen::packet_stream_id(packet) == 0x12345678);
+    CHECK(vrtgen::packet_time(packet) == expected);
+    CHECK_FALSE(vrtgen::packet_time(std::span{ packet }.first(16)));
+    CHECK_FALSE(vrtgen::packet_message_id(packet));
+}
+
+TEST_CASE("Command packet message ID", "[utility]")
+{
+    // Command packet with stream ID, CAM and message ID
+    bytes plain{ 0x60, 0x00, 0x00, 0x04,
+                 0x12, 0x34, 0x56, 0x78,
+                 0x00, 0x00, 0x00, 0x00,
+                 0x00, 0x00, 0x00, 0x2A };
+    CHECK(vrtgen::packet_message_id(plain) == 0x2A);
+    CHECK_FALSE(vrtgen::packet_message_id(std::span{ plain }.first(12)));
+
+    // Class ID and UTC/real-time timestamps precede the CAM
+    bytes stamped{ 0x68, 0x60, 0x00, 0x09,
+                   0x12, 0x34, 0x56, 0x78,
+                   0x00, 0x00, 0x00, 0x00,
+                   0x00, 0x00, 0x00, 0x00,
+                   0x5F, 0xEE, 0x66, 0x01,
+                   0x00, 0x00, 0x00, 0x00,
+                   0x00, 0x00, 0x00, 0x00,
+                   0x00, 0x00, 0x00, 0x00,
+                   0xDE, 0xAD, 0xBE, 0xEF };
+    CHECK(vrtgen::packet_message_id(stamped) == 0xDEADBEEF);
+}
+
+TEST_CASE("Duplicate command cache", "[utility]")
+{
+    // Command packet with controllee ID (word) and controller ID (UUID) enabled
+    bytes command{ 0x60, 0x00, 0x00, 0x09,
+                   0x12, 0x34, 0x56, 0x78,
+                   0xB0, 0x00, 0x00, 0x00,
+                   0x00, 0x00, 0x00, 0x07,
+                   0xAA, 0xAA, 0xAA, 0xAA,
+                   0x01, 0x02, 0x03, 0x04,
+                   0x05, 0x06, 0x07, 0x08,
+                   0x09, 0x0A, 0x0B, 0x0C,
+                   0x0D, 0x0E, 0x0F, 0x10 };
+    auto key = vrtgen::packet_command_key(command);
+    REQUIRE(key);
+    CHECK(key->stream_id == 0x12345678);
+    CHECK(key->message_id == 7);
+    CHECK(key->controller_id == std::array<uint8_t, 16>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 });
+    CHECK_FALSE(vrtgen::packet_command_key(std::span{ command }.first(24)));
+
+    vrtgen::duplicate_cache cache(2);
+    const bytes acks{ 1, 2, 3, 4 };
+    CHECK(cache.find(*key, command) == nullptr);
+    cache.insert(*key, command, acks);
+    auto found = cache.find(*key, command);
+    REQUIRE(found != nullptr);
+    CHECK(*found == acks);
+    CHECK(cache.hits() == 1);
+
+    // Same key with different contents is a new command, e.g. after a controller restart
+    auto changed = command;
+    changed.back() = 0xFF;
+    CHECK(cache.find(*key, changed) == nullptr);
+
+    // Oldest entries are evicted once capacity is reached
+    auto other = *key;
+    for (auto id : { 8U, 9U }) {
+        other.message_id = id;
+        cache.insert(other, command, {});
+    }
+    CHECK(cache.find(*key, command) == nullptr);
+    other.message_id = 9;
+    CHECK(cache.find(other, command) != nullptr);
+
+    // The same command from another sender is not a retransmission
+    cache.insert(*key, command, acks);
+    auto moved = *key;
+    moved.sender = 1;
+    CHECK(cache.find(moved, command) == nullptr);
+    CHECK(cache.find(*key, command) != nullptr);
+
+    // Nor is it once the retransmission window has passed
+    using namespace std::chrono_literals;
+    const auto now = vrtgen::duplicate_cache::clock::now();
+    CHECK(cache.window() == vrtgen::duplicate_cache::DEFAULT_WINDOW);
+    cache.window(100ms);
+    cache.insert(*key, command, acks, now);
+    CHECK(cache.find(*key, command, now + 99ms) != nullptr);
+    CHECK(cache.find(*key, command, now + 100ms) == nullptr);
+    CHECK(cache.find(*key, command, now) == nullptr);
+
+    cache.capacity(0);
+    cache.insert(*key, command, acks);
+    CHECK(cache.find(*key, command) == nullptr);
+}
+
+TEST_CASE("Expiring value", "[utility]")
+{
+    using namespace std::chrono_literals;
+    using clock = vrtgen::expiring_value<double>::clock;
+    const auto now = clock::now();
+
+    // Disabled until a time-to-live is set
+    vrtgen::expiring_value<double> value;
+    CHECK_FALSE(value.enabled());
+    value.set(1.5, now);
+    CHECK(value.get(now) == nullptr);
+
+    value.ttl(10ms);
+    CHECK(value.enabled());
+    CHECK(value.ttl() == 10ms);
+    value.set(1.5, now);
+    REQUIRE(value.get(now + 9ms) != nullptr);
+    CHECK(*value.get(now + 9ms) == 1.5);
+    CHECK(value.get(now + 10ms) == nullptr);
+
+    value.set(2.5, now);
+    value.reset();
+    CHECK(value.get(now) == nullptr);
+
+    // Changing the time-to-live discards the stored value
+    value.set(2.5, now);
+    value.ttl(1s);
+    CHECK(value.get(now) == nullptr);
+}
+
+TEST_CASE("Socket buffer sizing and drop accounting", "[socket][udp]")
+{
+    udp::v4 receiver;
+    udp::v4 sender;
+    REQUIRE(receiver.bind({ "127.0.0.1", 0 }));
+    auto local = local_endpoint(receiver);
+
+    // The kernel doubles the requested size to account for bookkeeping overhead
+    REQUIRE(sender.send_buffer_size(65536));
+    CHECK(sender.send_buffer_size() == 2 * 65536);
+    REQUIRE(receiver.receive_buffer_size(4096));
+    CHECK(receiver.receive_buffer_size() == 2 * 4096);
+
+    REQUIRE(receiver.drop_counting(true));
+    receiver.receive_buffer_autotune(65536);
+    CHECK(receiver.drops() == 0);
+
+    // Overflow the small receive buffer
+    constexpr std::size_t COUNT = 64;
+    const bytes message(1024, 0xAB);
+    for (auto i = std::size_t{}; i < COUNT; ++i) {
+        sender.send_to(message.data(), message.size(), local);
+    }
+
+    std::array<uint8_t, 2048> buffer;
+    std::array<std::span<uint8_t>, 1> buffers{ buffer };
+    std::array<std::size_t, 1> lengths;
+    std::array<endpoint::udp::v4, 1> sources;
+    REQUIRE(receiver.nonblocking(true));
+    while (receiver.receive_batch(buffers, lengths, sources) > 0) {
+    }
+    // The drop count is stamped on each datagram as it is queued, so the
+    // datagrams that fit before the overflow still report zero
+    REQUIRE(sender.send_to(message.data(), message.size(), local) == static_cast<ssize_t>(message.size()));
+    REQUIRE(receiver.receive_batch(buffers, lengths, sources) == 1);
+    CHECK(receiver.drops() > 0);
+    CHECK(receiver.drops() < COUNT);
+    CHECK(receiver.receive_buffer_size() > 2 * 4096);
+}
+
+TEST_CASE("Busy poll receive", "[socket][udp]")
+{
+    using namespace std::chrono_literals;
+    udp::v4 receiver;
+    udp::v4 sender;
+    REQUIRE(receiver.bind({ "127.0.0.1", 0 }));
+    auto local = local_endpoint(receiver);
+    CHECK(receiver.busy_poll() == 0us);
+    // SO_BUSY_POLL may be refused without CAP_NET_ADMIN, the spin still applies
+    receiver.busy_poll(50us);
+    CHECK(receiver.busy_poll() == 50us);
+
+    const bytes message{ 1, 2, 3, 4 };
+    REQUIRE(sender.send_to(message.data(), message.size(), local) == static_cast<ssize_t>(message.size()));
+    std::array<uint8_t, 64> buffer;
+    endpoint::udp::v4 source;
+    CHECK(receiver.receive_from(buffer.data(), buffer.size(), source) == static_cast<ssize_t>(message.size()));
+
+    // Once the spin budget is exhausted the receive blocks until the socket timeout
+    receiver.timeout(1);
+    const auto start = std::chrono::steady_clock::now();
+    CHECK(receiver.receive_from(buffer.data(), buffer.size(), source) < 0);
+    CHECK(std::chrono::steady_clock::now() - start >= 900ms);
+}
+
+// Hidden benchmark, run with: test_libvrtgen "[benchmark]"
+TEST_CASE("Busy poll loopback round-trip latency", "[.][benchmark][socket][udp]")
+{
+    using namespace std::chrono_literals;
+    constexpr auto WARMUP = 1000;
+    constexpr auto ROUND_TRIPS = 20000;
+
+    struct mode
+    {
+        const char* name;
+        std::chrono::microseconds budget;
+        bool yield;
+    };
+    const std::array<mode, 3> modes{ {
+        { "blocking", 0us, false },
+        { "busy poll", 50us, false },
+        { "busy poll + yield", 50us, true },
+    } };
+
+    for (const auto& [name, budget, yield] : modes) {
+        udp::v4 client;
+        udp::v4 server;
+        REQUIRE(client.bind({ "127.0.0.1", 0 }));
+        REQUIRE(server.bind({ "127.0.0.1", 0 }));
+        const auto client_endpoint = local_endpoint(client);
+        const auto server_endpoint = local_endpoint(server);
+        client.busy_poll(budget, yield);
+        server.busy_poll(budget, yield);
+
+        // Echo every datagram back to the client until a zero-length datagram arrives
+        std::thread echo([&server, &client_endpoint]
+        {
+            std::array<uint8_t, 64> buffer;
+            endpoint::udp::v4 source;
+            auto len = ssize_t{};
+            while ((len = server.receive_from(buffer.data(), buffer.size(), source)) > 0) {
+                server.send_to(buffer.data(), static_cast<std::size_t>(len), client_endpoint);
+            }
+        });
+
+        const auto request = make_packet(8, 0xA5);
+        std::array<uint8_t, 64> reply;
+        endpoint::udp::v4 source;
+        std::vector<std::chrono::nanoseconds> samples;
+        samples.reserve(ROUND_TRIPS);
+        auto failures = 0;
+        for (auto i = 0; i < WARMUP + ROUND_TRIPS; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            client.send_to(request.data(), request.size(), server_endpoint);
+            if (client.receive_from(reply.data(), reply.size(), source) != static_cast<ssize_t>(request.size())) {
+                ++failures;
+                continue;
+            }
+            if (i >= WARMUP) {
+                samples.push_back(std::chrono::steady_clock::now() - start);
+            }
+        }
+        client.send_to(request.data(), 0, server_endpoint);
+        echo.join();
+
+        CHECK(failures == 0);
+        REQUIRE_FALSE(samples.empty());
+        std::sort(samples.begin(), samples.end());
+        const auto percentile = [&samples](const double p)
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                samples[static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1))]).count();
+        };
+        std::cout << name << ": p50 " << percentile(0.5) << " us, p99 " << percentile(0.99)
+                  << " us over " << samples.size() << " round trips" << std::endl;
+    }
+}
+
+TEST_CASE("UDP multicast", "[socket][udp]")
+{
+    const endpoint::udp::v4 group{ "239.255.86.49", 0 };
+    CHECK(group.is_multicast());
+    CHECK_FALSE(endpoint::udp::v4{ "127.0.0.1", 0 }.is_multicast());
+
+    udp::v4 receiver;
+    udp::v4 sender;
+    REQUIRE(receiver.bind({ "0.0.0.0", 0 }));
+    REQUIRE(receiver.nonblocking(true));
+    const auto destination = endpoint::udp::v4{ "239.255.86.49", local_endpoint(receiver).port() };
+    REQUIRE(sender.multicast_ttl(0));
+    REQUIRE(sender.multicast_loop(true));
+    REQUIRE(sender.multicast_interface(0));
+
+    std::array<uint8_t, 64> buffer;
+    endpoint::udp::v4 source;
+    const bytes message{ 1, 2, 3, 4 };
+    const auto exchange = [&]
+    {
+        sender.send_to(message.data(), message.size(), destination);
+        usleep(10000);
+        auto received = 0;
+        while (receiver.receive_from(buffer.data(), buffer.size(), source) > 0) {
+            ++received;
+        }
+        return received;
+    };
+
+    REQUIRE(receiver.join_group(group));
+    if (sender.send_to(message.data(), message.size(), destination) < 0) {
+        WARN("No multicast route available");
+        return;
+    }
+    usleep(10000);
+    REQUIRE(receiver.receive_from(buffer.data(), buffer.size(), source) == static_cast<ssize_t>(message.size()));
+    const auto sender_address = endpoint::udp::v4{ source.to_string().substr(0, source.to_string().find(':')), 0 };
+    REQUIRE(receiver.leave_group(group));
+    CHECK(exchange() == 0);
+
+    SECTION("Source-specific join filters other senders")
+    {
+        REQUIRE(receiver.join_source_group(group, { "192.0.2.254", 0 }));
+        CHECK(exchange() == 0);
+        REQUIRE(receiver.join_source_group(group, sender_address));
+        CHECK(exchange() == 1);
+        REQUIRE(receiver.leave_source_group(group, sender_address));
+        CHECK(exchange() == 0);
+    }
+
+    SECTION("Receivers sharing a group")
+    {
+        std::array<udp::v4, 2> receivers;
+        REQUIRE(receivers[0].bind_multicast(group));
+        const auto shared = endpoint::udp::v4{ "239.255.86.49", local_endpoint(receivers[0]).port() };
+        REQUIRE(receivers[1].bind_multicast(shared));
+        REQUIRE(sender.send_to(message.data(), message.size(), shared) == static_cast<ssize_t>(message.size()));
+        for (auto& member : receivers) {
+            CHECK(member.receive_from(buffer.data(), buffer.size(), source) == static_cast<ssize_t>(message.size()));
+        }
+    }
+}
+
+TEST_CASE("TCP gathered writes and coalescing writer", "[socket][tcp]")
+{
+    tcp::v4 server;
+    REQUIRE(server.bind({ "127.0.0.1", 0 }));
+    REQUIRE(server.listen());
+    tcp::v4::endpoint_type local;
+    getsockname(server.native_handle(), (sockaddr*)&local.sockaddr(), &local.socklen());
+    REQUIRE(server.nodelay(true));
+    tcp::v4 client;
+    REQUIRE(client.connect(local));
+    REQUIRE(server.accept());
+
+    int value{};
+    socklen_t len = sizeof(value);
+    REQUIRE(getsockopt(server.io_handle(), IPPROTO_TCP, TCP_NODELAY, &value, &len) == 0);
+    CHECK(value != 0);
+    REQUIRE(client.cork(true));
+
+    std::vector<bytes> packets;
+    for (auto i = 0; i < 8; ++i) {
+        packets.push_back(make_packet(static_cast<uint16_t>(4096 + i), static_cast<uint8_t>(i)));
+    }
+    std::vector<std::span<const uint8_t>> spans(packets.begin(), packets.end());
+    const auto total = std::accumulate(packets.begin(), packets.end(), std::size_t{},
+                                       [](auto sum, const auto& packet) { return sum + packet.size(); });
+
+    // Write from another thread so short writes resume while the reader drains;
+    // results are checked on this thread since Catch2 assertions are not thread-safe
+    auto gathered = ssize_t{};
+    auto staged = std::size_t{};
+    auto flushed = false;
+    std::thread writer([&]
+    {
+        gathered = client.write_all(spans);
+        tcp::writer_v4 coalescing(client, 1 << 20);
+        for (const auto& packet : packets) {
+            coalescing.write(packet);
+        }
+        staged = coalescing.staged();
+        flushed = coalescing.flush();
+        client.cork(false);
+    });
+
+    vrtgen::packet_framer framer;
+    std::vector<bytes> framed;
+    while (framed.size() < 2 * packets.size() && framer.read_from(server) > 0) {
+        framer.for_each([&framed](auto packet) { framed.emplace_back(packet.begin(), packet.end()); });
+    }
+    writer.join();
+    CHECK(gathered == static_cast<ssize_t>(total));
+    CHECK(staged == total);
+    CHECK(flushed);
+    REQUIRE(framed.size() == 2 * packets.size());
+    CHECK(std::equal(packets.begin(), packets.end(), framed.begin()));
+    CHECK(std::equal(packets.begin(), packets.end(), framed.begin() + packets.size()));
+}
+
+TEST_CASE("TCP gathered write limits", "[socket][tcp]")
+{
+    using namespace std::chrono_literals;
+    tcp::v4 server;
+    REQUIRE(server.bind({ "127.0.0.1", 0 }));
+    REQUIRE(server.listen());
+    tcp::v4::endpoint_type local;
+    getsockname(server.native_handle(), (sockaddr*)&local.sockaddr(), &local.socklen());
+    tcp::v4 client;
+    REQUIRE(client.connect(local));
+    REQUIRE(server.accept());
+
+    // More buffers than fit in one sendmsg() are written in several batches
+    std::vector<bytes> packets;
+    for (auto i = std::size_t{}; i < 3 * tcp::v4::IOVEC_BATCH + 1; ++i) {
+        packets.push_back(make_packet(4, static_cast<uint8_t>(i)));
+    }
+    std::vector<std::span<const uint8_t>> spans(packets.begin(), packets.end());
+    CHECK(client.write_all(spans) == static_cast<ssize_t>(packets.size() * packets.front().size()));
+    vrtgen::packet_framer framer;
+    std::vector<bytes> framed;
+    while (framed.size() < packets.size() && framer.read_from(server) > 0) {
+        framer.for_each([&framed](auto packet) { framed.emplace_back(packet.begin(), packet.end()); });
+    }
+    CHECK(framed == packets);
+
+    // A non-blocking writer gives up after the send timeout when the reader stalls;
+    // the receive timeout does not apply
+    client.timeout(10);
+    client.send_timeout(1);
+    REQUIRE(client.nonblocking(true));
+    const bytes flood(64 << 20);
+    const auto start = std::chrono::steady_clock::now();
+    CHECK(client.write_all(flood.data(), flood.size()) < 0);
+    CHECK(errno == ETIMEDOUT);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    CHECK(elapsed >= 900ms);
+    CHECK(elapsed < 3s);
+}
+
+TEST_CASE("Receive with a deadline", "[socket]")
+{
+    using namespace std::chrono_literals;
+    udp::v4 receiver;
+    udp::v4 sender;
+    REQUIRE(receiver.bind({ "127.0.0.1", 0 }));
+    auto local = local_endpoint(receiver);
+    std::array<uint8_t, 64> buffer;
+    endpoint::udp::v4 source;
+
+    auto start = std::chrono::steady_clock::now();
+    CHECK(receiver.receive_for(buffer.data(), buffer.size(), source, 50ms) < 0);
+    CHECK(errno == ETIMEDOUT);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    CHECK(elapsed >= 50ms);
+    // Well short of the socket receive timeout
+    CHECK(elapsed < 1s);
+
+    const bytes message{ 1, 2, 3, 4 };
+    REQUIRE(sender.send_to(message.data(), message.size(), local) == static_cast<ssize_t>(message.size()));
+    CHECK(receiver.receive_for(buffer.data(), buffer.size(), source, 1s) == static_cast<ssize_t>(message.size()));
+
+    tcp::v4 server;
+    REQUIRE(server.bind({ "127.0.0.1", 0 }));
+    REQUIRE(server.listen());
+    tcp::v4::endpoint_type server_endpoint;
+    getsockname(server.native_handle(), (sockaddr*)&server_endpoint.sockaddr(), &server_endpoint.socklen());
+    tcp::v4 client;
+    REQUIRE(client.connect(server_endpoint));
+    REQUIRE(server.accept());
+    CHECK(server.read_for(buffer.data(), buffer.size(), 20ms) < 0);
+    CHECK(errno == ETIMEDOUT);
+    REQUIRE(client.write_all(message.data(), message.size()) == static_cast<ssize_t>(message.size()));
+    CHECK(server.read_for(buffer.data(), buffer.size(), 1s) == static_cast<ssize_t>(message.size()));
+    client.shutdown(SHUT_WR);
+    CHECK(server.read_for(buffer.data(), buffer.size(), 1s) == 0);
+
+    // Dropping the connection leaves the listening socket ready for the next one
+    CHECK(server.connected());
+    server.disconnect();
+    CHECK_FALSE(server.connected());
+    CHECK(server.io_handle() == server.native_handle());
+    tcp::v4 next_client;
+    REQUIRE(next_client.connect(server_endpoint));
+    REQUIRE(server.accept());
+    CHECK(server.connected());
+}